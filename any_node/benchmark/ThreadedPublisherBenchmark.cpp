@@ -0,0 +1,148 @@
+/*!
+ * @file    ThreadedPublisherBenchmark.cpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ *
+ * Benchmark of the ThreadedPublisher with a stand-in publisher, such that no ros master is needed. For each combination of message size,
+ * buffer size and producer rate, a producer publishes messages for a fixed duration and the benchmark reports:
+ *  - the latency of publish(..) seen by the caller (percentiles),
+ *  - the throughput with which the publishing thread drains the buffer,
+ *  - the ratio of messages dropped because the buffer was full.
+ *
+ * Usage: any_node_threaded_publisher_benchmark [duration per run in s, default 0.5] [publish cost of the stand-in in us, default 0]
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <std_msgs/UInt8MultiArray.h>
+
+#include "any_node/ThreadedPublisher.hpp"
+
+#include "BenchmarkUtils.hpp"
+
+namespace {
+
+using any_node::benchmark::getPercentile;
+
+using Clock = std::chrono::steady_clock;
+using Message = std_msgs::UInt8MultiArray;
+
+/*!
+ * Publisher counting the published messages instead of sending them, optionally busy waiting to emulate the cost of serialization.
+ * Copies share the counter, like copies of a ros::Publisher share the topic.
+ */
+class StandInPublisher {
+ public:
+  explicit StandInPublisher(const double publishCost = 0.0)
+      : publishCost_(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(publishCost))) {}
+
+  void publish(const Message& /*message*/) const {
+    if (publishCost_ > Clock::duration::zero()) {
+      const auto end = Clock::now() + publishCost_;
+      while (Clock::now() < end) {
+      }
+    }
+    (*numPublished_)++;
+  }
+
+  std::string getTopic() const { return "/benchmark"; }
+  uint32_t getNumSubscribers() const { return 1; }
+  bool isLatched() const { return false; }
+  void shutdown() {}
+
+  unsigned int getNumPublished() const { return *numPublished_; }
+
+ private:
+  Clock::duration publishCost_;
+  std::shared_ptr<std::atomic<unsigned int>> numPublished_{std::make_shared<std::atomic<unsigned int>>(0)};
+};
+
+struct Result {
+  unsigned int numProduced_{0};
+  unsigned int numPublished_{0};
+  unsigned int numDropped_{0};
+  std::vector<double> enqueueLatencies_;
+  double drainDuration_{0.0};
+};
+
+/*!
+ * Publish messages of a size at a rate (as fast as possible if not positive) for a duration.
+ */
+Result run(const unsigned int messageSize, const unsigned int bufferSize, const double rate, const double duration,
+           const double publishCost) {
+  StandInPublisher standInPublisher(publishCost);
+  Result result;
+  {
+    any_node::ThreadedPublisher<Message, StandInPublisher> publisher(standInPublisher, bufferSize);
+    Message message;
+    message.data.resize(messageSize);
+
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(duration));
+    const auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(rate > 0.0 ? 1.0 / rate : 0.0));
+    auto next = start;
+    while (Clock::now() < end) {
+      if (rate > 0.0) {
+        std::this_thread::sleep_until(next);
+        next += period;
+      }
+      message.data[0] = static_cast<uint8_t>(result.numProduced_);
+      const auto publishStart = Clock::now();
+      publisher.publish(message);
+      result.enqueueLatencies_.push_back(std::chrono::duration<double>(Clock::now() - publishStart).count());
+      result.numProduced_++;
+    }
+
+    // Wait until the buffer is drained, i.e. no message was published for a while.
+    auto lastPublishTime = Clock::now();
+    unsigned int numPublished = standInPublisher.getNumPublished();
+    while (Clock::now() - lastPublishTime < std::chrono::milliseconds(20)) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+      if (standInPublisher.getNumPublished() != numPublished) {
+        numPublished = standInPublisher.getNumPublished();
+        lastPublishTime = Clock::now();
+      }
+    }
+    result.drainDuration_ = std::chrono::duration<double>(lastPublishTime - start).count();
+    result.numDropped_ = publisher.getNumDroppedMessages();
+  }
+  result.numPublished_ = standInPublisher.getNumPublished();
+  std::sort(result.enqueueLatencies_.begin(), result.enqueueLatencies_.end());
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const double duration = argc > 1 ? std::atof(argv[1]) : 0.5;
+  const double publishCost = argc > 2 ? std::atof(argv[2]) * 1e-6 : 0.0;
+
+  const std::vector<unsigned int> messageSizes{64, 4096, 262144};
+  const std::vector<unsigned int> bufferSizes{1, 10, 100};
+  const std::vector<double> rates{1000.0, 10000.0, 0.0};
+
+  std::printf("%10s %8s %10s | %10s %10s %10s %10s | %12s %8s\n", "size [B]", "buffer", "rate [Hz]", "p50 [us]", "p90 [us]", "p99 [us]",
+              "max [us]", "drain [1/s]", "drop [%]");
+  for (const auto messageSize : messageSizes) {
+    for (const auto bufferSize : bufferSizes) {
+      for (const auto rate : rates) {
+        const Result result = run(messageSize, bufferSize, rate, duration, publishCost);
+        const auto& latencies = result.enqueueLatencies_;
+        const double dropRatio = result.numProduced_ == 0 ? 0.0 : static_cast<double>(result.numDropped_) / result.numProduced_;
+        std::printf("%10u %8u %10s | %10.2f %10.2f %10.2f %10.2f | %12.0f %8.2f\n", messageSize, bufferSize,
+                    rate > 0.0 ? std::to_string(static_cast<int>(rate)).c_str() : "max", getPercentile(latencies, 50.0) * 1e6,
+                    getPercentile(latencies, 90.0) * 1e6, getPercentile(latencies, 99.0) * 1e6,
+                    latencies.empty() ? 0.0 : latencies.back() * 1e6, result.numPublished_ / result.drainDuration_, dropRatio * 100.0);
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,415 @@
+/*!
+ * @file    AsyncServiceClient.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+#ifndef ROS2_BUILD
+
+// c++
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ros
+#include <ros/ros.h>
+
+#include <any_worker/ThreadPool.hpp>
+#include <message_logger/message_logger.hpp>
+
+#include "any_node/LatencyHistogram.hpp"
+
+namespace any_node {
+
+enum class ServiceCallStatus : unsigned int {
+  Success = 0,  //!< The service returned true.
+  Failure,      //!< The service returned false or could not be reached.
+  Timeout,      //!< The deadline passed before the service returned.
+  Rejected,     //!< The call queue was full.
+  Cancelled,    //!< The client was shut down before the call was executed.
+  NumStatuses
+};
+
+template <class Service>
+struct ServiceCallResult {
+  ServiceCallStatus status_{ServiceCallStatus::Failure};
+  typename Service::Response response_{};
+  //! Round trip time in seconds, NaN if the service was not called.
+  double latency_{std::numeric_limits<double>::quiet_NaN()};
+
+  bool isSuccess() const { return status_ == ServiceCallStatus::Success; }
+};
+
+/*!
+ * Service client executing the calls on its own thread pool, such that the caller (e.g. a control worker) never blocks on the round trip.
+ *
+ * Each call returns a future or invokes a callback with the result. Calls can have a deadline, after which they complete with status
+ * Timeout even if the service has not returned yet (ROS1 calls cannot be aborted, the late response is discarded). Calls which are still
+ * queued at their deadline are not executed at all.
+ * The ros::ServiceClients are reused between calls (one per concurrently running call), so persistent connections are kept open. A
+ * persistent client whose connection dropped is replaced on the next call.
+ * Callbacks are executed from the pool threads, or from the deadline thread on timeout. They must not block.
+ * Shutting down waits a bounded time for the running calls. Calls to a hung service are abandoned after it: They complete with status
+ * Cancelled and their pool threads terminate on their own once the service returns.
+ */
+template <class Service>
+class AsyncServiceClient {
+ public:
+  using Request = typename Service::Request;
+  using Response = typename Service::Response;
+  using Result = ServiceCallResult<Service>;
+  using Callback = std::function<void(const Result&)>;
+  using Clock = std::chrono::steady_clock;
+
+  /*!
+   * @param nh            Node handle.
+   * @param service       Service name.
+   * @param persistent    Keep the connections to the service open between calls.
+   * @param numThreads    Number of calls executed concurrently.
+   * @param maxQueueSize  Maximum number of calls waiting for execution, 0 means unbounded. Calls exceeding it are rejected.
+   * @param header_values Connection header values.
+   */
+  AsyncServiceClient(ros::NodeHandle& nh, std::string service, bool persistent = false, unsigned int numThreads = 1,
+                     unsigned int maxQueueSize = 0, ros::M_string header_values = ros::M_string())
+      : nh_(nh),
+        service_(std::move(service)),
+        persistent_(persistent),
+        headerValues_(std::move(header_values)),
+        pool_("async_service_client:" + service_, numThreads, maxQueueSize) {
+    deadlineThread_ = std::thread(&AsyncServiceClient::checkDeadlines, this);
+  }
+
+  AsyncServiceClient(const AsyncServiceClient&) = delete;
+  AsyncServiceClient& operator=(const AsyncServiceClient&) = delete;
+
+  virtual ~AsyncServiceClient() { shutdown(); }
+
+  /*!
+   * Call the service asynchronously.
+   * @param request Request.
+   * @param timeout Time in seconds from now until the call times out, no deadline if not positive.
+   * @return        Future of the result, which is ready immediately if the call was rejected.
+   */
+  std::shared_future<Result> call(const Request& request, const double timeout = 0.0) {
+    const CallPtr newCall = makeCall(request, Callback());
+    submit(newCall, timeout);
+    return newCall->future_;
+  }
+
+  /*!
+   * Call the service asynchronously.
+   * @param request  Request.
+   * @param callback Callback which is invoked exactly once with the result, also if the call is rejected.
+   * @param timeout  Time in seconds from now until the call times out, no deadline if not positive.
+   * @return         False if the call was rejected.
+   */
+  bool call(const Request& request, Callback callback, const double timeout = 0.0) {
+    return submit(makeCall(request, std::move(callback)), timeout);
+  }
+
+  /*!
+   * Stop accepting calls, cancel the queued calls and wait for the running calls to finish.
+   * @param timeout Time in seconds to wait for the running calls, which are abandoned and cancelled after it.
+   */
+  void shutdown(const double timeout = 1.0) {
+    if (shutdownRequested_.exchange(true)) {
+      return;
+    }
+    if (!pool_.stop(timeout)) {
+      {
+        // Waits for the calls which are completing, the abandoned ones do not access the client anymore once they return.
+        std::lock_guard<std::mutex> lock(liveness_->mutex_);
+        liveness_->alive_ = false;
+      }
+      std::vector<CallPtr> pendingCalls;
+      {
+        std::lock_guard<std::mutex> lock(deadlinesMutex_);
+        pendingCalls.assign(pendingCalls_.begin(), pendingCalls_.end());
+      }
+      MELO_WARN("Async service client: %lu call(s) to %s did not return within %f s, cancelling them.", pendingCalls.size(),
+                service_.c_str(), timeout);
+      for (const auto& call : pendingCalls) {
+        Result result;
+        result.status_ = ServiceCallStatus::Cancelled;
+        complete(call, result);
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock(deadlinesMutex_);
+      stopDeadlineThread_ = true;
+    }
+    deadlinesCv_.notify_all();
+    if (deadlineThread_.joinable()) {
+      deadlineThread_.join();
+    }
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    for (auto& client : idleClients_) {
+      client.shutdown();
+    }
+    idleClients_.clear();
+  }
+
+  const std::string& getService() const { return service_; }
+
+  unsigned int getNumPendingCalls() const { return pool_.getQueueSize() + pool_.getNumActive(); }
+
+  unsigned int getNumCalls(const ServiceCallStatus status) const {
+    std::lock_guard<std::mutex> lock(statisticsMutex_);
+    return numCalls_[static_cast<unsigned int>(status)];
+  }
+
+  /*!
+   * @return Histogram of the round trip times in seconds of all executed calls, including the ones which timed out.
+   */
+  LatencyHistogram getLatency() const {
+    std::lock_guard<std::mutex> lock(statisticsMutex_);
+    return latency_;
+  }
+
+  void resetStatistics() {
+    std::lock_guard<std::mutex> lock(statisticsMutex_);
+    numCalls_.fill(0);
+    latency_.reset();
+  }
+
+ protected:
+  struct Call;
+  using CallPtr = std::shared_ptr<Call>;
+  using Deadlines = std::multimap<Clock::time_point, CallPtr>;
+
+  /*!
+   * Shared with the tasks of the pool, such that tasks abandoned by shutdown() do not access the client after it is destroyed.
+   */
+  struct Liveness {
+    std::mutex mutex_;
+    bool alive_{true};
+  };
+
+  struct Call {
+    Request request_;
+    Callback callback_;
+    std::promise<Result> promise_;
+    std::shared_future<Result> future_{promise_.get_future().share()};
+    std::atomic<bool> completed_{false};
+    //! Entry in the deadlines, only valid if hasDeadline_ is true. Guarded by the deadlines mutex.
+    typename Deadlines::iterator deadline_;
+    bool hasDeadline_{false};
+  };
+
+  static CallPtr makeCall(const Request& request, Callback callback) {
+    auto call = std::make_shared<Call>();
+    call->request_ = request;
+    call->callback_ = std::move(callback);
+    return call;
+  }
+
+  /*!
+   * Queue a call, it is completed with status Rejected if the queue is full.
+   * @param call    Call.
+   * @param timeout Time in seconds from now until the call times out, no deadline if not positive.
+   * @return        False if the call was rejected.
+   */
+  bool submit(const CallPtr& call, const double timeout) {
+    {
+      std::lock_guard<std::mutex> lock(deadlinesMutex_);
+      pendingCalls_.insert(call);
+    }
+    if (timeout > 0.0) {
+      std::lock_guard<std::mutex> lock(deadlinesMutex_);
+      const auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(timeout));
+      call->deadline_ = deadlines_.emplace(deadline, call);
+      call->hasDeadline_ = true;
+      if (call->deadline_ == deadlines_.begin()) {
+        deadlinesCv_.notify_all();
+      }
+    }
+
+    if (shutdownRequested_ || !pool_.submit([this, call, liveness = liveness_]() { execute(call, liveness); })) {
+      Result result;
+      result.status_ = ServiceCallStatus::Rejected;
+      complete(call, result);
+      return false;
+    }
+    return true;
+  }
+
+  void execute(const CallPtr& call, const std::shared_ptr<Liveness>& liveness) {
+    std::unique_lock<std::mutex> lock(liveness->mutex_);
+    if (!liveness->alive_ || call->completed_) {
+      // Abandoned by shutdown() or timed out while queued.
+      return;
+    }
+    Result result;
+    if (shutdownRequested_) {
+      result.status_ = ServiceCallStatus::Cancelled;
+      const bool completed = recordCompletion(call, result);
+      lock.unlock();
+      if (completed) {
+        notifyCompletion(call, result);
+      }
+      return;
+    }
+
+    ros::ServiceClient client = acquireClient();
+    lock.unlock();
+    const auto startTime = Clock::now();
+    const bool success = client.call(call->request_, result.response_);
+    result.latency_ = std::chrono::duration<double>(Clock::now() - startTime).count();
+    result.status_ = success ? ServiceCallStatus::Success : ServiceCallStatus::Failure;
+    lock.lock();
+    if (!liveness->alive_) {
+      return;
+    }
+    releaseClient(client);
+
+    {
+      std::lock_guard<std::mutex> lock(statisticsMutex_);
+      latency_.add(result.latency_);
+    }
+    const bool completed = recordCompletion(call, result);
+    // The callback is invoked without the lock, such that it may shut down or destroy the client and callbacks of different calls do
+    // not serialize. It only accesses the call, which is kept alive by this task.
+    lock.unlock();
+    if (completed) {
+      notifyCompletion(call, result);
+    }
+  }
+
+  /*!
+   * Complete a call with a result, ignored if the call is already completed.
+   */
+  void complete(const CallPtr& call, const Result& result) {
+    if (recordCompletion(call, result)) {
+      notifyCompletion(call, result);
+    }
+  }
+
+  /*!
+   * Mark a call as completed and remove it from the pending calls and the deadlines, accessing the client.
+   * @return False if the call is already completed.
+   */
+  bool recordCompletion(const CallPtr& call, const Result& result) {
+    if (call->completed_.exchange(true)) {
+      return false;
+    }
+    {
+      std::lock_guard<std::mutex> lock(deadlinesMutex_);
+      pendingCalls_.erase(call);
+      if (call->hasDeadline_) {
+        deadlines_.erase(call->deadline_);
+        call->hasDeadline_ = false;
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock(statisticsMutex_);
+      numCalls_[static_cast<unsigned int>(result.status_)]++;
+    }
+    return true;
+  }
+
+  /*!
+   * Set the result of a completed call and invoke its callback, without accessing the client.
+   */
+  static void notifyCompletion(const CallPtr& call, const Result& result) {
+    call->promise_.set_value(result);
+    if (call->callback_) {
+      call->callback_(result);
+    }
+  }
+
+  void checkDeadlines() {
+    std::unique_lock<std::mutex> lock(deadlinesMutex_);
+    while (!stopDeadlineThread_) {
+      if (deadlines_.empty()) {
+        deadlinesCv_.wait(lock);
+        continue;
+      }
+      if (deadlinesCv_.wait_until(lock, deadlines_.begin()->first) != std::cv_status::timeout) {
+        // A call with an earlier deadline was added or a call completed.
+        continue;
+      }
+
+      std::vector<CallPtr> expiredCalls;
+      const auto now = Clock::now();
+      while (!deadlines_.empty() && deadlines_.begin()->first <= now) {
+        expiredCalls.push_back(deadlines_.begin()->second);
+        expiredCalls.back()->hasDeadline_ = false;
+        deadlines_.erase(deadlines_.begin());
+      }
+
+      lock.unlock();
+      for (const auto& call : expiredCalls) {
+        Result result;
+        result.status_ = ServiceCallStatus::Timeout;
+        complete(call, result);
+      }
+      lock.lock();
+    }
+  }
+
+  ros::ServiceClient acquireClient() {
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    if (idleClients_.empty()) {
+      return nh_.serviceClient<Service>(service_, persistent_, headerValues_);
+    }
+    ros::ServiceClient client = idleClients_.back();
+    idleClients_.pop_back();
+    return client;
+  }
+
+  void releaseClient(ros::ServiceClient& client) {
+    if (persistent_ && !client.isValid()) {
+      // The persistent connection dropped, a new client is created on the next call.
+      MELO_DEBUG_STREAM("Async service client: Connection to " << service_ << " dropped.")
+      client.shutdown();
+      return;
+    }
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    idleClients_.push_back(client);
+  }
+
+  ros::NodeHandle nh_;
+  const std::string service_;
+  const bool persistent_;
+  const ros::M_string headerValues_;
+
+  std::atomic<bool> shutdownRequested_{false};
+
+  std::mutex clientsMutex_;
+  std::vector<ros::ServiceClient> idleClients_;
+
+  std::mutex deadlinesMutex_;
+  std::condition_variable deadlinesCv_;
+  Deadlines deadlines_;
+  //! Calls which are not completed yet, guarded by the deadlines mutex.
+  std::set<CallPtr> pendingCalls_;
+  bool stopDeadlineThread_{false};
+  std::thread deadlineThread_;
+
+  mutable std::mutex statisticsMutex_;
+  std::array<unsigned int, static_cast<unsigned int>(ServiceCallStatus::NumStatuses)> numCalls_{};
+  LatencyHistogram latency_;
+
+  const std::shared_ptr<Liveness> liveness_{std::make_shared<Liveness>()};
+  any_worker::ThreadPool pool_;
+};
+
+template <class Service>
+using AsyncServiceClientPtr = std::shared_ptr<AsyncServiceClient<Service>>;
+
+}  // namespace any_node
+
+#endif /* ROS2_BUILD */
@@ -0,0 +1,188 @@
+/*!
+ * @file    CachingServiceClient.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+#ifndef ROS2_BUILD
+
+// c++
+#include <chrono>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// ros
+#include <ros/serialization.h>
+
+#include "any_node/AsyncServiceClient.hpp"
+
+namespace any_node {
+
+/*!
+ * Layer over an AsyncServiceClient for idempotent services (e.g. map or configuration queries), which reduces the number of calls:
+ *  - Coalescing: Identical requests issued while a call with the same request is in flight share its result instead of calling again.
+ *  - Caching: Successful responses are cached for a time to live and returned for identical requests without calling the service.
+ * Requests are identical if their serialized representations are equal. Coalesced requests share the deadline of the first request.
+ * All methods are thread-safe.
+ */
+template <class Service>
+class CachingServiceClient {
+ public:
+  using Request = typename Service::Request;
+  using Result = ServiceCallResult<Service>;
+  using Clock = std::chrono::steady_clock;
+
+  /*!
+   * @param client       Client executing the calls, it is shut down together with this object.
+   * @param timeToLive   Time in seconds a successful response is cached, responses are not cached if not positive.
+   * @param maxCacheSize Maximum number of cached responses, the oldest response is evicted first.
+   */
+  explicit CachingServiceClient(AsyncServiceClientPtr<Service> client, const double timeToLive = 0.0, const unsigned int maxCacheSize = 16)
+      : client_(std::move(client)),
+        timeToLive_(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(timeToLive))),
+        maxCacheSize_(maxCacheSize) {}
+
+  CachingServiceClient(const CachingServiceClient&) = delete;
+  CachingServiceClient& operator=(const CachingServiceClient&) = delete;
+
+  virtual ~CachingServiceClient() { shutdown(); }
+
+  /*!
+   * Shut down the client, which completes all calls in flight.
+   * @param timeout Time in seconds to wait for the running calls, which are abandoned and cancelled after it.
+   */
+  void shutdown(const double timeout = 1.0) { client_->shutdown(timeout); }
+
+  /*!
+   * Call the service asynchronously, unless the response is cached or an identical call is in flight.
+   * @param request Request.
+   * @param timeout Time in seconds from now until the call times out, no deadline if not positive.
+   * @return        Future of the result.
+   */
+  std::shared_future<Result> call(const Request& request, const double timeout = 0.0) {
+    const std::string key = serialize(request);
+    std::shared_ptr<std::promise<Result>> promise;
+    std::shared_future<Result> future;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto cacheIt = cacheIndex_.find(key);
+      if (cacheIt != cacheIndex_.end()) {
+        if (Clock::now() < cacheIt->second->expiry_) {
+          numHits_++;
+          std::promise<Result> cachedPromise;
+          cachedPromise.set_value(cacheIt->second->result_);
+          return cachedPromise.get_future().share();
+        }
+        cache_.erase(cacheIt->second);
+        cacheIndex_.erase(cacheIt);
+      }
+
+      auto inFlightIt = inFlightCalls_.find(key);
+      if (inFlightIt != inFlightCalls_.end()) {
+        numCoalesced_++;
+        return inFlightIt->second;
+      }
+
+      numCalls_++;
+      promise = std::make_shared<std::promise<Result>>();
+      future = promise->get_future().share();
+      inFlightCalls_.emplace(key, future);
+    }
+
+    // Not locked, the callback is invoked right away if the call is rejected.
+    client_->call(request, [this, key, promise](const Result& result) { complete(key, *promise, result); }, timeout);
+    return future;
+  }
+
+  /*!
+   * Remove all cached responses.
+   */
+  void clearCache() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.clear();
+    cacheIndex_.clear();
+  }
+
+  const AsyncServiceClientPtr<Service>& getClient() const { return client_; }
+
+  //! Number of requests answered from the cache.
+  unsigned int getNumHits() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return numHits_;
+  }
+
+  //! Number of requests which shared the result of an identical call in flight.
+  unsigned int getNumCoalesced() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return numCoalesced_;
+  }
+
+  //! Number of requests forwarded to the client.
+  unsigned int getNumCalls() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return numCalls_;
+  }
+
+ protected:
+  struct CacheEntry {
+    std::string key_;
+    Clock::time_point expiry_;
+    Result result_;
+  };
+  using Cache = std::list<CacheEntry>;
+
+  static std::string serialize(const Request& request) {
+    std::string buffer(ros::serialization::serializationLength(request), '\0');
+    ros::serialization::OStream stream(reinterpret_cast<uint8_t*>(&buffer[0]), static_cast<uint32_t>(buffer.size()));
+    ros::serialization::serialize(stream, request);
+    return buffer;
+  }
+
+  void complete(const std::string& key, std::promise<Result>& promise, const Result& result) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      inFlightCalls_.erase(key);
+      if (result.isSuccess() && timeToLive_ > Clock::duration::zero() && maxCacheSize_ > 0) {
+        auto cacheIt = cacheIndex_.find(key);
+        if (cacheIt != cacheIndex_.end()) {
+          cache_.erase(cacheIt->second);
+          cacheIndex_.erase(cacheIt);
+        }
+        if (cache_.size() >= maxCacheSize_) {
+          cacheIndex_.erase(cache_.front().key_);
+          cache_.pop_front();
+        }
+        cache_.push_back(CacheEntry{key, Clock::now() + timeToLive_, result});
+        cacheIndex_.emplace(key, std::prev(cache_.end()));
+      }
+    }
+    promise.set_value(result);
+  }
+
+  const AsyncServiceClientPtr<Service> client_;
+  const Clock::duration timeToLive_;
+  const unsigned int maxCacheSize_;
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_future<Result>> inFlightCalls_;
+  //! Cached responses ordered by insertion, hence by expiry.
+  Cache cache_;
+  std::unordered_map<std::string, typename Cache::iterator> cacheIndex_;
+  unsigned int numHits_{0};
+  unsigned int numCoalesced_{0};
+  unsigned int numCalls_{0};
+};
+
+template <class Service>
+using CachingServiceClientPtr = std::shared_ptr<CachingServiceClient<Service>>;
+
+}  // namespace any_node
+
+#endif /* ROS2_BUILD */
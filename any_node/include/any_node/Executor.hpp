@@ -0,0 +1,90 @@
+/*!
+ * @file    Executor.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+#ifdef ROS2_BUILD
+
+// c++
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ros
+#include <rclcpp/rclcpp.hpp>
+
+namespace any_node {
+
+/*!
+ * Executes the callbacks of a ROS 2 node, replacing the async spinners of ROS 1.
+ *
+ * The callbacks of the default callback group are executed by the main executor, whose type is read from the parameter executor.type:
+ *  - static_single_threaded: lowest overhead, all default callbacks are executed sequentially.
+ *  - multi_threaded (default): callbacks are executed by numThreads threads.
+ * Additional callback groups are listed in the parameter executor.callback_group_names. Each of them is executed by its own executor and
+ * threads, configured by the parameters executor.callback_groups.<name>.{num_threads,priority,cpu,reentrant}. This isolates time
+ * critical callbacks from the others and allows to run them with a real-time priority on a dedicated cpu.
+ */
+class Executor {
+ public:
+  struct CallbackGroupOptions {
+    std::string name_;
+    //! Number of threads, a single threaded executor is used for one thread.
+    unsigned int numThreads_{1};
+    //! SCHED_FIFO priority of the threads, 0 keeps the default scheduling.
+    int priority_{0};
+    //! Cpu the threads are pinned to, -1 to not pin them.
+    int cpu_{-1};
+    //! If true, the callbacks of the group may be executed concurrently.
+    bool reentrant_{false};
+  };
+
+  /*!
+   * Create the executors and callback groups from the parameters of the node.
+   * @param node       Node.
+   * @param numThreads Number of threads of the multi threaded main executor, 0 means the number of cpu cores.
+   */
+  Executor(rclcpp::Node::SharedPtr node, unsigned int numThreads);
+  Executor(const Executor&) = delete;
+  Executor& operator=(const Executor&) = delete;
+  virtual ~Executor();
+
+  /*!
+   * Start the threads executing the callbacks.
+   */
+  void start();
+
+  /*!
+   * Stop executing callbacks and join the threads.
+   */
+  void stop();
+
+  /*!
+   * @return Callback groups configured in the parameters by name.
+   */
+  std::map<std::string, rclcpp::CallbackGroup::SharedPtr> getCallbackGroups() const;
+
+ private:
+  struct CallbackGroup {
+    CallbackGroupOptions options_;
+    rclcpp::CallbackGroup::SharedPtr group_;
+    std::shared_ptr<rclcpp::Executor> executor_;
+    std::thread thread_;
+  };
+
+  static std::shared_ptr<rclcpp::Executor> createExecutor(bool singleThreaded, unsigned int numThreads);
+
+  rclcpp::Node::SharedPtr node_;
+  std::shared_ptr<rclcpp::Executor> executor_;
+  std::thread thread_;
+  std::vector<std::unique_ptr<CallbackGroup>> callbackGroups_;
+};
+
+}  // namespace any_node
+
+#endif /* ROS2_BUILD */
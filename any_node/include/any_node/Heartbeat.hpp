@@ -0,0 +1,238 @@
+/*!
+ * @file    Heartbeat.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+// c++
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ros
+#ifndef ROS2_BUILD
+#include <ros/ros.h>
+#include <std_msgs/UInt64.h>
+#else /* ROS2_BUILD */
+#include <rclcpp/rclcpp.hpp>
+#include <std_msgs/msg/u_int64.hpp>
+#endif /* ROS2_BUILD */
+
+#include "any_node/MessageStamp.hpp"
+
+namespace any_node {
+
+/*!
+ * A heartbeat is a std_msgs/UInt64 published by Node (see Node::startHeartbeat()). Its lower 32 bits contain a sequence number,
+ * which allows to detect missed heartbeats and restarts, the upper 32 bits contain health flags: A bit is set if the worker it is assigned
+ * to exceeded the error threshold of its rate since the previous heartbeat. Each worker keeps its bit while the node runs, see
+ * Node::startHeartbeat() for how the bits are assigned and looked up.
+ */
+namespace heartbeat {
+
+inline uint64_t encode(const uint32_t sequence, const uint32_t healthFlags) {
+  return (static_cast<uint64_t>(healthFlags) << 32u) | sequence;
+}
+
+inline uint32_t getSequence(const uint64_t heartbeat) {
+  return static_cast<uint32_t>(heartbeat);
+}
+
+inline uint32_t getHealthFlags(const uint64_t heartbeat) {
+  return static_cast<uint32_t>(heartbeat >> 32u);
+}
+
+}  // namespace heartbeat
+
+/*!
+ * Tracks the heartbeats of peer nodes. A peer is alive if its last heartbeat was received less than the timeout ago.
+ * The timeouts are detected by check(), which has to be called periodically, e.g. from a worker.
+ * All methods are thread-safe.
+ */
+class HeartbeatMonitor {
+ public:
+  struct PeerStatus {
+    bool alive_{false};
+    uint32_t sequence_{0};
+    uint32_t healthFlags_{0};
+    //! Receive time of the last heartbeat in nanoseconds.
+    int64_t lastReceiveTime_{0};
+    unsigned int numReceived_{0};
+    //! Number of heartbeats missed according to the sequence numbers.
+    unsigned int numMissed_{0};
+  };
+
+  //! Callback invoked when a peer becomes alive or dead.
+  using Callback = std::function<void(const std::string& peer, const PeerStatus& status)>;
+
+  /*!
+   * @param timeout  Time in seconds after the last heartbeat until a peer is considered dead.
+   * @param callback Callback invoked on liveness changes, not called with locked mutex.
+   */
+  explicit HeartbeatMonitor(const double timeout, Callback callback = Callback())
+      : timeout_(static_cast<int64_t>(timeout * 1e9)), callback_(std::move(callback)) {}
+
+  HeartbeatMonitor(const HeartbeatMonitor&) = delete;
+  HeartbeatMonitor& operator=(const HeartbeatMonitor&) = delete;
+  virtual ~HeartbeatMonitor() = default;
+
+  /*!
+   * Add a peer, which is dead until its first heartbeat is received.
+   */
+  void addPeer(const std::string& peer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    peers_.emplace(peer, PeerStatus());
+  }
+
+#ifndef ROS2_BUILD
+  /*!
+   * Add a peer and subscribe to its heartbeat.
+   */
+  void subscribe(ros::NodeHandle& nh, const std::string& peer, const std::string& topic) {
+    addPeer(peer);
+    const boost::function<void(const std_msgs::UInt64ConstPtr&)> callback = [this, peer](const std_msgs::UInt64ConstPtr& msg) {
+      receive(peer, msg->data, internal::getRosTimeNow());
+    };
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscribers_.push_back(nh.subscribe<std_msgs::UInt64>(topic, 1, callback));
+  }
+#else  /* ROS2_BUILD */
+  /*!
+   * Add a peer and subscribe to its heartbeat.
+   */
+  void subscribe(rclcpp::Node& nh, const std::string& peer, const std::string& topic) {
+    addPeer(peer);
+    auto clock = nh.get_clock();
+    auto subscriber = nh.create_subscription<std_msgs::msg::UInt64>(
+        topic, rclcpp::QoS(1).best_effort(), [this, peer, clock](const std_msgs::msg::UInt64::ConstSharedPtr msg) {
+          receive(peer, msg->data, internal::getRosTimeNow(clock));
+        });
+    std::lock_guard<std::mutex> lock(mutex_);
+    clock_ = std::move(clock);
+    subscribers_.push_back(std::move(subscriber));
+  }
+#endif /* ROS2_BUILD */
+
+  /*!
+   * Process a received heartbeat.
+   * @param peer      Name of the peer, unknown peers are added.
+   * @param heartbeat Heartbeat.
+   * @param time      Receive time in nanoseconds.
+   */
+  void receive(const std::string& peer, const uint64_t heartbeat, const int64_t time) {
+    PeerStatus status;
+    bool becameAlive = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& peerStatus = peers_[peer];
+      const uint32_t sequence = heartbeat::getSequence(heartbeat);
+      // A sequence number which did not increase indicates a restart of the peer.
+      if (peerStatus.numReceived_ > 0 && sequence > peerStatus.sequence_) {
+        peerStatus.numMissed_ += sequence - peerStatus.sequence_ - 1;
+      }
+      peerStatus.sequence_ = sequence;
+      peerStatus.healthFlags_ = heartbeat::getHealthFlags(heartbeat);
+      peerStatus.lastReceiveTime_ = time;
+      peerStatus.numReceived_++;
+      becameAlive = !peerStatus.alive_;
+      peerStatus.alive_ = true;
+      status = peerStatus;
+    }
+    if (becameAlive && callback_) {
+      callback_(peer, status);
+    }
+  }
+
+  /*!
+   * Mark the peers as dead whose last heartbeat is older than the timeout.
+   * @param time Current time in nanoseconds.
+   */
+  void check(const int64_t time) {
+    std::vector<std::pair<std::string, PeerStatus>> diedPeers;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (auto& peer : peers_) {
+        if (peer.second.alive_ && time - peer.second.lastReceiveTime_ > timeout_) {
+          peer.second.alive_ = false;
+          diedPeers.emplace_back(peer.first, peer.second);
+        }
+      }
+    }
+    if (callback_) {
+      for (const auto& peer : diedPeers) {
+        callback_(peer.first, peer.second);
+      }
+    }
+  }
+
+#ifndef ROS2_BUILD
+  void check() { check(internal::getRosTimeNow()); }
+#else  /* ROS2_BUILD */
+  //! Check with the clock of the node subscribed with last.
+  void check() {
+    rclcpp::Clock::SharedPtr clock;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      clock = clock_;
+    }
+    check(internal::getRosTimeNow(clock));
+  }
+#endif /* ROS2_BUILD */
+
+  bool isAlive(const std::string& peer) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = peers_.find(peer);
+    return it != peers_.end() && it->second.alive_;
+  }
+
+  //! True if all peers are alive and report no health flags.
+  bool areAllHealthy() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& peer : peers_) {
+      if (!peer.second.alive_ || peer.second.healthFlags_ != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /*!
+   * Get the status of a peer.
+   * @param peer   Name of the peer.
+   * @param status Status of the peer.
+   * @return       True if the peer exists.
+   */
+  bool getStatus(const std::string& peer, PeerStatus& status) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto it = peers_.find(peer);
+    if (it == peers_.end()) {
+      return false;
+    }
+    status = it->second;
+    return true;
+  }
+
+ protected:
+  const int64_t timeout_;
+  const Callback callback_;
+
+  mutable std::mutex mutex_;
+  std::map<std::string, PeerStatus> peers_;
+#ifndef ROS2_BUILD
+  std::vector<ros::Subscriber> subscribers_;
+#else  /* ROS2_BUILD */
+  std::vector<rclcpp::Subscription<std_msgs::msg::UInt64>::SharedPtr> subscribers_;
+  rclcpp::Clock::SharedPtr clock_{internal::getDefaultRosClock()};
+#endif /* ROS2_BUILD */
+};
+
+using HeartbeatMonitorPtr = std::shared_ptr<HeartbeatMonitor>;
+
+}  // namespace any_node
@@ -0,0 +1,104 @@
+/*!
+ * @file    LatencyHistogram.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+// c++
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+#include "any_node/RunningStatistics.hpp"
+
+namespace any_node {
+
+/*!
+ * Histogram of latencies with logarithmically spaced buckets from 1 us to 100 s, in constant memory.
+ * Percentiles are resolved to the upper bound of their bucket (about 26% relative resolution), mean, minimum and maximum are exact.
+ * Not thread-safe, the owner is responsible for the synchronization.
+ */
+class LatencyHistogram {
+ public:
+  //! Number of buckets per decade.
+  static constexpr unsigned int NumBucketsPerDecade_{10};
+  //! Decimal exponent of the lower bound of the first bucket.
+  static constexpr int MinExponent_{-6};
+  //! Decimal exponent of the upper bound of the last bucket.
+  static constexpr int MaxExponent_{2};
+  //! Number of buckets, including one for underflows and one for overflows.
+  static constexpr unsigned int NumBuckets_{(MaxExponent_ - MinExponent_) * NumBucketsPerDecade_ + 2};
+
+  /*!
+   * Add a latency, NaN latencies are ignored.
+   * @param latency Latency in seconds.
+   */
+  void add(const double latency) {
+    if (std::isnan(latency)) {
+      return;
+    }
+    counts_[getBucketIndex(latency)]++;
+    statistics_.add(latency);
+  }
+
+  void reset() { *this = LatencyHistogram(); }
+
+  unsigned int getNumSamples() const { return statistics_.getNumSamples(); }
+
+  /*!
+   * @return Mean, standard deviation, minimum and maximum of the latencies in seconds.
+   */
+  const RunningStatistics& getStatistics() const { return statistics_; }
+
+  /*!
+   * Get a percentile of the latencies.
+   * @param percentile Percentile in the range [0, 100].
+   * @return           Upper bound of the bucket containing the percentile in seconds, NaN if empty.
+   */
+  double getPercentile(const double percentile) const {
+    const unsigned int numSamples = getNumSamples();
+    if (numSamples == 0) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+    const auto rank = static_cast<unsigned int>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * numSamples));
+    unsigned int cumulatedCount = 0;
+    for (unsigned int i = 0; i < NumBuckets_; i++) {
+      cumulatedCount += counts_[i];
+      if (cumulatedCount >= std::max(rank, 1u)) {
+        return std::clamp(getBucketUpperBound(i), statistics_.getMin(), statistics_.getMax());
+      }
+    }
+    return statistics_.getMax();
+  }
+
+  const std::array<unsigned int, NumBuckets_>& getCounts() const { return counts_; }
+
+  /*!
+   * Get the upper bound of a bucket.
+   * @param index Bucket index.
+   * @return      Upper bound in seconds, infinity for the overflow bucket.
+   */
+  static double getBucketUpperBound(const unsigned int index) {
+    if (index >= NumBuckets_ - 1) {
+      return std::numeric_limits<double>::infinity();
+    }
+    return std::pow(10.0, MinExponent_ + static_cast<double>(index) / NumBucketsPerDecade_);
+  }
+
+ private:
+  static unsigned int getBucketIndex(const double latency) {
+    if (latency <= std::pow(10.0, MinExponent_)) {
+      return 0;
+    }
+    const double index = std::ceil((std::log10(latency) - MinExponent_) * NumBucketsPerDecade_);
+    return static_cast<unsigned int>(std::min(index, static_cast<double>(NumBuckets_ - 1)));
+  }
+
+  std::array<unsigned int, NumBuckets_> counts_{};
+  RunningStatistics statistics_;
+};
+
+}  // namespace any_node
@@ -0,0 +1,194 @@
+/*!
+ * @file    LatencyTracer.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+// c++
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include "any_node/LatencyHistogram.hpp"
+#include "any_node/MessageStamp.hpp"
+
+namespace any_node {
+
+/*!
+ * Traces the latency of a node within a processing chain (e.g. sensor -> estimator -> controller).
+ *
+ * The trace context is the header stamp of the messages: By convention, it is the time of the original measurement and each node copies
+ * it from its input to its output. Based on this, the tracer records three latency histograms:
+ *  - Input latency: Chain latency from the origin to the reception by this node (receive time minus stamp).
+ *  - Output latency: Chain latency from the origin to the publication by this node (publish time minus stamp).
+ *  - Node latency: Time between the reception of an input and the publication of an output with the same stamp.
+ * The total latency of a chain is the output latency of its last node, the transport latency between two nodes is the difference of the
+ * input latency of the receiving and the output latency of the sending node.
+ *
+ * Inputs are traced by the subscribe helpers (through SubscriberStatistics) and outputs by the ThreadedPublisher. All methods are
+ * thread-safe.
+ */
+class LatencyTracer {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  //! Number of recent inputs kept to match outputs against.
+  static constexpr unsigned int NumPendingInputs_{32};
+
+  explicit LatencyTracer(std::string name = "") : name_(std::move(name)) {}
+
+#ifndef ROS2_BUILD
+  /*!
+   * Trace a received message, ignored if it has no stamp.
+   * @param msg Message.
+   */
+  template <typename MessageType>
+  void traceInput(const MessageType& msg) {
+    const int64_t stamp = internal::getMessageStamp(msg);
+    if (stamp != 0) {
+      addInput(stamp, internal::getRosTimeNow());
+    }
+  }
+
+  /*!
+   * Trace a published message, ignored if it has no stamp.
+   * @param msg Message.
+   */
+  template <typename MessageType>
+  void traceOutput(const MessageType& msg) {
+    const int64_t stamp = internal::getMessageStamp(msg);
+    if (stamp != 0) {
+      addOutput(stamp, internal::getRosTimeNow());
+    }
+  }
+#else  /* ROS2_BUILD */
+  /*!
+   * Trace a received message, ignored if it has no stamp.
+   * @param msg   Message.
+   * @param clock Clock of the node.
+   */
+  template <typename MessageType>
+  void traceInput(const MessageType& msg, const rclcpp::Clock::SharedPtr& clock = internal::getDefaultRosClock()) {
+    const int64_t stamp = internal::getMessageStamp(msg);
+    if (stamp != 0) {
+      addInput(stamp, internal::getRosTimeNow(clock));
+    }
+  }
+
+  /*!
+   * Trace a published message, ignored if it has no stamp.
+   * @param msg   Message.
+   * @param clock Clock of the node.
+   */
+  template <typename MessageType>
+  void traceOutput(const MessageType& msg, const rclcpp::Clock::SharedPtr& clock = internal::getDefaultRosClock()) {
+    const int64_t stamp = internal::getMessageStamp(msg);
+    if (stamp != 0) {
+      addOutput(stamp, internal::getRosTimeNow(clock));
+    }
+  }
+#endif /* ROS2_BUILD */
+
+  /*!
+   * Add an input.
+   * @param stamp Stamp of the message in nanoseconds.
+   * @param now   Ros time of the reception in nanoseconds.
+   * @param time  Steady time of the reception.
+   */
+  void addInput(const int64_t stamp, const int64_t now, const Clock::time_point& time = Clock::now()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    inputLatency_.add(1e-9 * static_cast<double>(now - stamp));
+    pendingInputs_[nextPendingInput_] = PendingInput{stamp, time};
+    nextPendingInput_ = (nextPendingInput_ + 1) % NumPendingInputs_;
+  }
+
+  /*!
+   * Add an output.
+   * @param stamp Stamp of the message in nanoseconds.
+   * @param now   Ros time of the publication in nanoseconds.
+   * @param time  Steady time of the publication.
+   */
+  void addOutput(const int64_t stamp, const int64_t now, const Clock::time_point& time = Clock::now()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    outputLatency_.add(1e-9 * static_cast<double>(now - stamp));
+
+    // Search the most recent input with the same stamp.
+    for (unsigned int i = 1; i <= NumPendingInputs_; i++) {
+      const PendingInput& input = pendingInputs_[(nextPendingInput_ + NumPendingInputs_ - i) % NumPendingInputs_];
+      if (input.stamp_ == stamp) {
+        nodeLatency_.add(std::chrono::duration<double>(time - input.time_).count());
+        break;
+      }
+    }
+  }
+
+  void reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    inputLatency_.reset();
+    outputLatency_.reset();
+    nodeLatency_.reset();
+    pendingInputs_.fill(PendingInput{});
+  }
+
+  const std::string& getName() const { return name_; }
+
+  LatencyHistogram getInputLatency() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return inputLatency_;
+  }
+
+  LatencyHistogram getOutputLatency() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return outputLatency_;
+  }
+
+  LatencyHistogram getNodeLatency() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return nodeLatency_;
+  }
+
+  /*!
+   * @return Human readable summary of the latency histograms in milliseconds.
+   */
+  std::string getReport() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::stringstream report;
+    report << "Latency tracer '" << name_ << "' [ms]:";
+    const auto printHistogram = [&report](const std::string& name, const LatencyHistogram& histogram) {
+      report << std::fixed << std::setprecision(3) << "\n  " << name << ": n=" << histogram.getNumSamples()
+             << " mean=" << 1e3 * histogram.getStatistics().getMean() << " p50=" << 1e3 * histogram.getPercentile(50.0)
+             << " p90=" << 1e3 * histogram.getPercentile(90.0) << " p99=" << 1e3 * histogram.getPercentile(99.0)
+             << " max=" << 1e3 * histogram.getStatistics().getMax();
+    };
+    printHistogram("input ", inputLatency_);
+    printHistogram("node  ", nodeLatency_);
+    printHistogram("output", outputLatency_);
+    return report.str();
+  }
+
+ private:
+  struct PendingInput {
+    int64_t stamp_{0};
+    Clock::time_point time_{};
+  };
+
+  const std::string name_;
+
+  mutable std::mutex mutex_;
+  std::array<PendingInput, NumPendingInputs_> pendingInputs_{};
+  unsigned int nextPendingInput_{0};
+  LatencyHistogram inputLatency_;
+  LatencyHistogram outputLatency_;
+  LatencyHistogram nodeLatency_;
+};
+
+using LatencyTracerPtr = std::shared_ptr<LatencyTracer>;
+
+}  // namespace any_node
@@ -0,0 +1,216 @@
+/*!
+ * @file    MessageLog.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+// c++
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace any_node {
+
+/*!
+ * Binary log of serialized messages, written by MessageLogWriter and read by MessageLogReader.
+ *
+ * The file starts with a header followed by records, each consisting of a RecordHeader and its payload padded to 8 bytes:
+ *  - Connection records describe a topic (payload: topic, data type, md5 sum and definition, each prefixed by its uint32 length).
+ *  - Message records contain a serialized message of a connection.
+ *  - Padding records fill the rest of a chunk.
+ * The file grows in chunks which are memory-mapped while they are written. The header of a record is written after its payload. The file
+ * header contains the offset up to which the records are committed, i.e. synced to disk by a flush. When the writer is closed, the index
+ * of all messages and a footer pointing to it are appended. The index of a file without footer (e.g. after a crash) is rebuilt by the
+ * reader from the committed records.
+ */
+namespace message_log {
+
+constexpr char FileMagic_[8] = {'A', 'N', 'Y', 'L', 'O', 'G', '0', '1'};
+constexpr char FooterMagic_[8] = {'A', 'N', 'Y', 'I', 'D', 'X', '0', '1'};
+
+enum class RecordType : uint32_t { End = 0, Connection = 1, Message = 2, Padding = 3 };
+
+struct RecordHeader {
+  RecordType type_{RecordType::End};
+  uint32_t connectionId_{0};
+  //! Time of the message in nanoseconds.
+  int64_t stamp_{0};
+  //! Size of the payload without padding.
+  uint32_t size_{0};
+  uint32_t reserved_{0};
+};
+
+struct IndexEntry {
+  int64_t stamp_{0};
+  //! Offset of the record header in the file.
+  uint64_t offset_{0};
+};
+
+//! Footer at the end of a closed file. The index entries are followed by the offsets (uint64) of the connection records.
+struct Footer {
+  char magic_[8]{};
+  uint64_t indexOffset_{0};
+  uint64_t numIndexEntries_{0};
+  uint64_t numConnections_{0};
+};
+
+struct Connection {
+  uint32_t id_{0};
+  std::string topic_;
+  std::string dataType_;
+  std::string md5Sum_;
+  std::string definition_;
+};
+
+//! Size of a record with the given payload size, including header and padding.
+inline uint64_t getRecordSize(const uint64_t payloadSize) {
+  return sizeof(RecordHeader) + ((payloadSize + 7) & ~static_cast<uint64_t>(7));
+}
+
+}  // namespace message_log
+
+/*!
+ * Appends serialized messages to a message log. The messages are serialized directly into the memory-mapped file, such that writing a
+ * message costs little more than serializing it. The records are written to disk by flush(), which does not block the writing.
+ * All methods are thread-safe.
+ */
+class MessageLogWriter {
+ public:
+  //! Function serializing a message of the announced size into the given buffer.
+  using Serializer = std::function<void(uint8_t* buffer)>;
+
+  MessageLogWriter() = default;
+  MessageLogWriter(const MessageLogWriter&) = delete;
+  MessageLogWriter& operator=(const MessageLogWriter&) = delete;
+  virtual ~MessageLogWriter();
+
+  /*!
+   * Create a log file, an existing file is overwritten.
+   * @param path      Path of the file.
+   * @param chunkSize Size in bytes by which the file grows, messages larger than it get a chunk of their own.
+   * @return          True if successful.
+   */
+  virtual bool open(const std::string& path, uint64_t chunkSize = 4u << 20u);
+
+  /*!
+   * Write the index, truncate the unused part of the last chunk and close the file.
+   */
+  virtual void close();
+
+  bool isOpen() const;
+
+  /*!
+   * Add a connection.
+   * @return Id of the connection, to be passed when writing messages.
+   */
+  uint32_t addConnection(const std::string& topic, const std::string& dataType, const std::string& md5Sum, const std::string& definition);
+
+  /*!
+   * Write a message.
+   * @param connectionId Id of the connection of the message.
+   * @param stamp        Time of the message in nanoseconds.
+   * @param size         Size of the serialized message.
+   * @param serializer   Function serializing the message into the file.
+   * @return             True if successful.
+   */
+  bool writeMessage(uint32_t connectionId, int64_t stamp, uint32_t size, const Serializer& serializer);
+
+  bool writeMessage(uint32_t connectionId, int64_t stamp, const uint8_t* data, uint32_t size);
+
+  /*!
+   * Sync the records written so far to disk and commit them, such that they are recovered if the file is not closed properly. Blocks
+   * until the data is on disk, but does not block writing messages meanwhile.
+   * @return True if successful.
+   */
+  bool flush();
+
+  uint64_t getNumMessages() const;
+
+  //! Number of bytes written so far.
+  uint64_t getSize() const;
+
+ protected:
+  uint8_t* reserveRecord(uint64_t recordSize);
+  bool mapChunk(uint64_t chunkSize);
+  void unmapChunk();
+
+  mutable std::mutex mutex_;
+  //! Held while flushing, such that the file is not closed meanwhile. Locked before the mutex.
+  std::mutex flushMutex_;
+  int fileDescriptor_{-1};
+  uint64_t chunkSize_{0};
+  //! Offset of the next record in the file.
+  uint64_t writeOffset_{0};
+  //! Mapped chunk and its offset in the file.
+  uint8_t* chunk_{nullptr};
+  uint64_t chunkOffset_{0};
+  uint64_t mappedSize_{0};
+  std::vector<uint64_t> connectionOffsets_;
+  std::vector<message_log::IndexEntry> index_;
+};
+
+/*!
+ * Reads a message log, which is memory-mapped as a whole.
+ */
+class MessageLogReader {
+ public:
+  struct Message {
+    const message_log::Connection* connection_{nullptr};
+    int64_t stamp_{0};
+    const uint8_t* data_{nullptr};
+    uint32_t size_{0};
+  };
+
+  MessageLogReader() = default;
+  MessageLogReader(const MessageLogReader&) = delete;
+  MessageLogReader& operator=(const MessageLogReader&) = delete;
+  virtual ~MessageLogReader();
+
+  /*!
+   * Open a log file and read its connections and index.
+   * @param path Path of the file.
+   * @return     True if successful.
+   */
+  bool open(const std::string& path);
+
+  void close();
+
+  const std::vector<message_log::Connection>& getConnections() const { return connections_; }
+
+  uint64_t getNumMessages() const { return index_.size(); }
+
+  /*!
+   * Get a message.
+   * @param index Index of the message, the messages are ordered by their stamps.
+   * @return      Message, pointing into the mapped file. Empty if the index is out of range or the record is corrupt.
+   */
+  Message getMessage(uint64_t index) const;
+
+  /*!
+   * Find the first message at or after a time, by binary search in the index.
+   * @param stamp Time in nanoseconds.
+   * @return      Index of the message, or the number of messages if all messages are older.
+   */
+  uint64_t seek(int64_t stamp) const;
+
+ protected:
+  bool readConnection(uint64_t offset);
+
+  /*!
+   * Rebuild the connections and the index from the records up to an offset.
+   */
+  void scanRecords(uint64_t endOffset);
+
+  uint8_t* data_{nullptr};
+  uint64_t size_{0};
+  //! End of the committed records, the messages have to lie before it.
+  uint64_t recordsEnd_{0};
+  std::vector<message_log::Connection> connections_;
+  std::vector<message_log::IndexEntry> index_;
+};
+
+}  // namespace any_node
@@ -0,0 +1,254 @@
+/*!
+ * @file    MessagePlayer.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+#ifndef ROS2_BUILD
+
+// c++
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// ros
+#include <ros/ros.h>
+#include <ros/serialization.h>
+#include <rosgraph_msgs/Clock.h>
+#include <topic_tools/shape_shifter.h>
+
+#include <any_worker/Worker.hpp>
+#include <message_logger/message_logger.hpp>
+
+#include "any_node/MessageLog.hpp"
+#include "any_node/ThreadedPublisher.hpp"
+
+namespace any_node {
+
+/*!
+ * Plays back a message log recorded by a MessageRecorder. The log is memory-mapped and the messages are published in the order of their
+ * stamps, without decoding them, through one ThreadedPublisher per recorded topic.
+ * The playback is driven by a worker, which publishes the messages whose stamps are reached by the playback clock in every cycle:
+ *  - With a positive rate, the playback clock runs at rate times the wall clock.
+ *  - Otherwise the messages are played as fast as possible, in batches of maxMessagesPerStep per cycle.
+ * Optionally, the playback clock is published on /clock, such that nodes using simulated time follow the playback also when it is
+ * accelerated.
+ */
+class MessagePlayer {
+ public:
+  /*!
+   * @param nh          Node handle used to advertise the topics.
+   * @param topicPrefix Prefix prepended to the recorded topics.
+   * @param queueSize   Queue size of the publishers.
+   */
+  explicit MessagePlayer(ros::NodeHandle& nh, std::string topicPrefix = "", const uint32_t queueSize = 100)
+      : nh_(nh), topicPrefix_(std::move(topicPrefix)), queueSize_(queueSize) {}
+
+  MessagePlayer(const MessagePlayer&) = delete;
+  MessagePlayer& operator=(const MessagePlayer&) = delete;
+
+  virtual ~MessagePlayer() { shutdown(); }
+
+  /*!
+   * Open a log and advertise its topics.
+   * @param path Path of the log file.
+   * @return     True if successful.
+   */
+  bool open(const std::string& path) {
+    stop();
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdownPublishers();
+    if (!reader_.open(path)) {
+      return false;
+    }
+    for (const auto& connection : reader_.getConnections()) {
+      topic_tools::ShapeShifter prototype;
+      prototype.morph(connection.md5Sum_, connection.dataType_, connection.definition_, "");
+      // The buffers are sent by the worker in every cycle, hence they need no size limit.
+      publishers_.push_back(std::make_shared<ThreadedPublisher<topic_tools::ShapeShifter>>(
+          prototype.advertise(nh_, topicPrefix_ + connection.topic_, queueSize_), std::numeric_limits<unsigned int>::max(), false));
+      prototypes_.push_back(std::move(prototype));
+    }
+    nextIndex_ = 0;
+    done_ = reader_.getNumMessages() == 0;
+    MELO_INFO("Message player: Opened %s with %lu messages on %lu topics.", path.c_str(), reader_.getNumMessages(),
+              reader_.getConnections().size());
+    return true;
+  }
+
+  /*!
+   * Start the playback from the current position.
+   * @param rate               Playback speed relative to the wall clock, as fast as possible if not positive.
+   * @param publishClock       Publish the playback clock on /clock.
+   * @param timeStep           Time step of the worker in seconds.
+   * @param maxMessagesPerStep Number of messages published per cycle when playing as fast as possible.
+   * @param priority           Priority of the worker.
+   * @return                   True if successful.
+   */
+  bool start(const double rate = 1.0, const bool publishClock = false, const double timeStep = 0.001,
+             const unsigned int maxMessagesPerStep = 1000, const int priority = 0) {
+    stop();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      rate_ = rate;
+      maxMessagesPerStep_ = std::max(maxMessagesPerStep, 1u);
+      if (publishClock && !clockPublisher_) {
+        clockPublisher_ = nh_.advertise<rosgraph_msgs::Clock>("/clock", 1);
+      }
+      publishClock_ = publishClock;
+      restartClock();
+    }
+    any_worker::WorkerOptions options("message_player", timeStep, [this](const any_worker::WorkerEvent& /*event*/) { return play(); },
+                                      priority);
+    worker_ = std::make_unique<any_worker::Worker>(options);
+    return worker_->start();
+  }
+
+  /*!
+   * Pause the playback.
+   */
+  void stop() {
+    if (worker_) {
+      worker_->stop(true);
+      worker_.reset();
+    }
+  }
+
+  void shutdown() {
+    stop();
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdownPublishers();
+    clockPublisher_.shutdown();
+    reader_.close();
+  }
+
+  /*!
+   * Continue the playback at the first message at or after a time.
+   * @param stamp Time in nanoseconds.
+   */
+  void seek(const int64_t stamp) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    nextIndex_ = reader_.seek(stamp);
+    done_ = nextIndex_ >= reader_.getNumMessages();
+    restartClock(stamp);
+  }
+
+  //! True if all messages were played.
+  bool isDone() const { return done_; }
+
+  //! Playback clock in nanoseconds.
+  int64_t getTime() const { return time_; }
+
+  const MessageLogReader& getReader() const { return reader_; }
+
+ protected:
+  using Clock = std::chrono::steady_clock;
+
+  /*!
+   * Anchor the playback clock at a time, by default at the stamp of the next message.
+   */
+  void restartClock(const int64_t stamp = std::numeric_limits<int64_t>::min()) {
+    if (stamp != std::numeric_limits<int64_t>::min()) {
+      time_ = stamp;
+    } else if (nextIndex_ < reader_.getNumMessages()) {
+      time_ = reader_.getMessage(nextIndex_).stamp_;
+    }
+    clockStartStamp_ = time_;
+    clockStartTime_ = Clock::now();
+  }
+
+  bool play() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (done_) {
+      return true;
+    }
+
+    const uint64_t numMessages = reader_.getNumMessages();
+    int64_t endStamp = std::numeric_limits<int64_t>::max();
+    uint64_t endIndex = numMessages;
+    if (rate_ > 0.0) {
+      const std::chrono::duration<double, std::nano> elapsed = Clock::now() - clockStartTime_;
+      endStamp = clockStartStamp_ + static_cast<int64_t>(elapsed.count() * rate_);
+    } else {
+      endIndex = std::min(numMessages, nextIndex_ + maxMessagesPerStep_);
+    }
+
+    for (; nextIndex_ < endIndex; nextIndex_++) {
+      const auto message = reader_.getMessage(nextIndex_);
+      if (message.stamp_ > endStamp) {
+        break;
+      }
+      if (message.connection_ == nullptr) {
+        continue;
+      }
+      // The prototype carries the type information, the copy gets a buffer of its own.
+      topic_tools::ShapeShifter shapeShifter = prototypes_[message.connection_->id_];
+      ros::serialization::IStream stream(const_cast<uint8_t*>(message.data_), message.size_);
+      shapeShifter.read(stream);
+      publishers_[message.connection_->id_]->publish(std::move(shapeShifter));
+      time_ = message.stamp_;
+    }
+    if (rate_ > 0.0) {
+      time_ = endStamp;
+    }
+    done_ = nextIndex_ >= numMessages;
+
+    // The clock is published first, such that the messages are not older than the clock of their subscribers.
+    if (publishClock_) {
+      rosgraph_msgs::Clock clock;
+      clock.clock.fromNSec(static_cast<uint64_t>(time_.load()));
+      clockPublisher_.publish(clock);
+    }
+    for (const auto& publisher : publishers_) {
+      publisher->sendRos();
+    }
+    if (done_) {
+      MELO_INFO("Message player: Played all messages.");
+    }
+    return true;
+  }
+
+  void shutdownPublishers() {
+    for (const auto& publisher : publishers_) {
+      publisher->shutdown();
+    }
+    publishers_.clear();
+    prototypes_.clear();
+  }
+
+  ros::NodeHandle nh_;
+  const std::string topicPrefix_;
+  const uint32_t queueSize_;
+
+  std::mutex mutex_;
+  MessageLogReader reader_;
+  //! Publishers and type information, indexed by connection id.
+  std::vector<ThreadedPublisherPtr<topic_tools::ShapeShifter>> publishers_;
+  std::vector<topic_tools::ShapeShifter> prototypes_;
+  ros::Publisher clockPublisher_;
+  bool publishClock_{false};
+  double rate_{1.0};
+  unsigned int maxMessagesPerStep_{1000};
+
+  uint64_t nextIndex_{0};
+  std::atomic<bool> done_{true};
+  std::atomic<int64_t> time_{0};
+  int64_t clockStartStamp_{0};
+  Clock::time_point clockStartTime_;
+
+  std::unique_ptr<any_worker::Worker> worker_;
+};
+
+using MessagePlayerPtr = std::shared_ptr<MessagePlayer>;
+
+}  // namespace any_node
+
+#endif /* ROS2_BUILD */
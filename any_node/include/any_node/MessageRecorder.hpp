@@ -0,0 +1,120 @@
+/*!
+ * @file    MessageRecorder.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+// c++
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// ros
+#ifndef ROS2_BUILD
+#include <ros/message_traits.h>
+#include <ros/serialization.h>
+#else /* ROS2_BUILD */
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+#include <rosidl_runtime_cpp/traits.hpp>
+#endif /* ROS2_BUILD */
+
+#include <any_worker/Worker.hpp>
+
+#include "any_node/MessageLog.hpp"
+
+namespace any_node {
+
+/*!
+ * Records ros messages into a message log. One recorder can be shared by several publishers (see ThreadedPublisher::setRecorder(..)).
+ * The recorded messages are flushed periodically by a worker, such that at most the messages of the last flush period are lost if the
+ * recorder is not closed properly.
+ * All methods are thread-safe.
+ */
+class MessageRecorder : public MessageLogWriter {
+ public:
+  /*!
+   * @param flushTimeStep Time in seconds between two flushes, the messages are only flushed when closing if not positive.
+   */
+  explicit MessageRecorder(const double flushTimeStep = 1.0) : flushTimeStep_(flushTimeStep) {}
+  ~MessageRecorder() override { close(); }
+
+  bool open(const std::string& path, uint64_t chunkSize = 4u << 20u) override {
+    close();
+    if (!MessageLogWriter::open(path, chunkSize)) {
+      return false;
+    }
+    if (flushTimeStep_ > 0.0) {
+      std::lock_guard<std::mutex> lock(flushWorkerMutex_);
+      flushWorker_ = std::make_unique<any_worker::Worker>("message_recorder_flush", flushTimeStep_,
+                                                          [this](const any_worker::WorkerEvent& /*event*/) { return flush(); });
+      flushWorker_->start();
+    }
+    return true;
+  }
+
+  void close() override {
+    {
+      std::lock_guard<std::mutex> lock(flushWorkerMutex_);
+      if (flushWorker_) {
+        flushWorker_->stop(true);
+        flushWorker_.reset();
+      }
+    }
+    MessageLogWriter::close();
+  }
+
+  /*!
+   * Add a connection for messages of the given type.
+   * @param topic   Topic of the messages.
+   * @param message Message, its type is taken from the instance such that it also works for topic_tools::ShapeShifter.
+   * @return        Id of the connection.
+   */
+  template <typename MessageType>
+  uint32_t addConnection(const std::string& topic, const MessageType& message) {
+#ifndef ROS2_BUILD
+    return MessageLogWriter::addConnection(topic, ros::message_traits::datatype(message), ros::message_traits::md5sum(message),
+                                           ros::message_traits::definition(message));
+#else  /* ROS2_BUILD */
+    (void)message;
+    return MessageLogWriter::addConnection(topic, rosidl_generator_traits::name<MessageType>(), "", "");
+#endif /* ROS2_BUILD */
+  }
+
+  /*!
+   * Serialize a message into the log.
+   * @param connectionId Id of the connection returned by addConnection(..).
+   * @param stamp        Time of the message in nanoseconds.
+   * @param message      Message.
+   * @return             True if successful.
+   */
+  template <typename MessageType>
+  bool record(const uint32_t connectionId, const int64_t stamp, const MessageType& message) {
+#ifndef ROS2_BUILD
+    const uint32_t size = ros::serialization::serializationLength(message);
+    return writeMessage(connectionId, stamp, size, [&message, size](uint8_t* buffer) {
+      ros::serialization::OStream stream(buffer, size);
+      ros::serialization::serialize(stream, message);
+    });
+#else  /* ROS2_BUILD */
+    // The rmw serializes into its own buffer, hence the message is copied once into the log.
+    static const rclcpp::Serialization<MessageType> serialization;
+    rclcpp::SerializedMessage serializedMessage;
+    serialization.serialize_message(&message, &serializedMessage);
+    const auto& rclMessage = serializedMessage.get_rcl_serialized_message();
+    return writeMessage(connectionId, stamp, rclMessage.buffer, static_cast<uint32_t>(rclMessage.buffer_length));
+#endif /* ROS2_BUILD */
+  }
+
+ protected:
+  const double flushTimeStep_;
+  std::mutex flushWorkerMutex_;
+  std::unique_ptr<any_worker::Worker> flushWorker_;
+};
+
+using MessageRecorderPtr = std::shared_ptr<MessageRecorder>;
+
+}  // namespace any_node
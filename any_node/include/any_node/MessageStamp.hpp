@@ -0,0 +1,82 @@
+/*!
+ * @file    MessageStamp.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+// c++
+#include <cstdint>
+#include <type_traits>
+
+// ros
+#ifndef ROS2_BUILD
+#include <ros/ros.h>
+#else /* ROS2_BUILD */
+#include "rclcpp/rclcpp.hpp"
+#endif /* ROS2_BUILD */
+
+namespace any_node {
+
+namespace internal {
+
+#ifdef ROS2_BUILD
+template <typename MessageType, typename = void>
+struct HasHeaderStamp : std::false_type {};
+
+template <typename MessageType>
+struct HasHeaderStamp<MessageType, std::void_t<decltype(std::declval<MessageType>().header.stamp)>> : std::true_type {};
+#endif /* ROS2_BUILD */
+
+/*!
+ * Get the stamp in the header of a message.
+ * @param msg Message.
+ * @return    Stamp in nanoseconds, 0 if the message has no header or the stamp is not set.
+ */
+template <typename MessageType>
+int64_t getMessageStamp(const MessageType& msg) {
+#ifndef ROS2_BUILD
+  const ros::Time* stamp = ros::message_traits::timeStamp(msg);
+  return (stamp == nullptr) ? 0 : static_cast<int64_t>(stamp->toNSec());
+#else  /* ROS2_BUILD */
+  if constexpr (HasHeaderStamp<MessageType>::value) {
+    return rclcpp::Time(msg.header.stamp).nanoseconds();
+  } else {
+    return 0;
+  }
+#endif /* ROS2_BUILD */
+}
+
+#ifndef ROS2_BUILD
+/*!
+ * Get the current ros time.
+ * @return Time in nanoseconds.
+ */
+inline int64_t getRosTimeNow() {
+  return static_cast<int64_t>(ros::Time::now().toNSec());
+}
+#else  /* ROS2_BUILD */
+/*!
+ * Get the clock used where no node clock is given. Created once, as creating a clock is expensive. Unlike the clock of a node, it does
+ * not follow use_sim_time.
+ * @return Clock of the ros time.
+ */
+inline const rclcpp::Clock::SharedPtr& getDefaultRosClock() {
+  static const auto clock = std::make_shared<rclcpp::Clock>(RCL_ROS_TIME);
+  return clock;
+}
+
+/*!
+ * Get the current ros time.
+ * @param clock Clock, the one of the node (node->get_clock()) such that simulated time is followed.
+ * @return      Time in nanoseconds.
+ */
+inline int64_t getRosTimeNow(const rclcpp::Clock::SharedPtr& clock = getDefaultRosClock()) {
+  return clock->now().nanoseconds();
+}
+#endif /* ROS2_BUILD */
+
+}  // namespace internal
+
+}  // namespace any_node
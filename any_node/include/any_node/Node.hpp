@@ -13,11 +13,14 @@
 #endif /* ROS2_BUILD */
 #include <sched.h>
 #include <unistd.h>  // for getpid()
-#include <memory>    // for std::shared_ptr
+#include <map>
+#include <memory>  // for std::shared_ptr
+#include <vector>
 
 #include <any_worker/WorkerManager.hpp>
 #include <any_worker/WorkerOptions.hpp>
 
+#include "any_node/Heartbeat.hpp"
 #include "any_node/Param.hpp"
 #include "any_node/Topic.hpp"
 
@@ -67,15 +70,53 @@ class Node {
   void shutdown();
 
   /*!
-   * Helper functions to add Workers to the WorkerManager
+   * Helper functions to add Workers to the WorkerManager.
+   * The options can be overridden per worker by the optional parameters workers/<name>/{time_step, priority, affinity, policy, cpu_set}
+   * (workers.<name>.* in ROS 2), see loadWorkerOptions(..).
    */
   template <class T>
   inline bool addWorker(const std::string& name, const double timestep, bool (T::*fp)(const any_worker::WorkerEvent&), T* obj,
                         const int priority = 0, const int affinity = -1) {
-    return workerManager_.addWorker(name, timestep, fp, obj, priority, true, affinity);
+    return addWorker(any_worker::WorkerOptions(name, timestep, std::bind(fp, obj, std::placeholders::_1), priority, affinity));
   }
 
-  inline bool addWorker(const any_worker::WorkerOptions& options) { return workerManager_.addWorker(options); }
+  inline bool addWorker(const any_worker::WorkerOptions& options) { return workerManager_.addWorker(loadWorkerOptions(options)); }
+
+  /*!
+   * Override worker options by the parameters of the worker, if present:
+   *  - time_step:  time step in seconds
+   *  - priority:   priority of the thread
+   *  - affinity:   CPU of the thread
+   *  - policy:     scheduling policy of the thread, one of fifo, rr, other, batch, idle
+   *  - cpu_set:    CPUs of the thread in the CPU list format, e.g. "2-3,6"
+   * The parameters are in the namespace workers/<name> (workers.<name> in ROS 2), where characters of the worker name other than letters,
+   * digits and underscores are replaced by underscores, e.g. workers/exampleNode__updateWorker for the worker exampleNode::updateWorker.
+   * @param options Options of the worker.
+   * @return        Options with the parameters applied.
+   */
+  any_worker::WorkerOptions loadWorkerOptions(any_worker::WorkerOptions options) const;
+
+  /*!
+   * Helper functions to add Workers which are parked while none of the given threaded publishers has a subscriber.
+   * An activation condition already set in the options has to be fulfilled as well.
+   * @param options     Options of the worker
+   * @param publishers  Threaded publishers the worker produces data for
+   * @return            True if the worker was added successfully
+   */
+  template <typename... Msgs>
+  inline bool addLazyWorker(any_worker::WorkerOptions options, const ThreadedPublisherPtr<Msgs>&... publishers) {
+    static_assert(sizeof...(Msgs) > 0, "A lazy worker needs to be bound to at least one threaded publisher.");
+    options.activationCondition_ = [condition = std::move(options.activationCondition_), publishers...]() {
+      return (!condition || condition()) && ((publishers->getNumSubscribers() > 0) || ...);
+    };
+    return workerManager_.addWorker(loadWorkerOptions(std::move(options)));
+  }
+
+  template <class T, typename... Msgs>
+  inline bool addLazyWorker(const std::string& name, const double timestep, bool (T::*fp)(const any_worker::WorkerEvent&), T* obj,
+                            const int priority, const ThreadedPublisherPtr<Msgs>&... publishers) {
+    return addLazyWorker(any_worker::WorkerOptions(name, timestep, std::bind(fp, obj, std::placeholders::_1), priority), publishers...);
+  }
 
   /*!
    * Check if WorkerManager is managing a Worker with given name
@@ -104,6 +145,44 @@ class Node {
    */
   inline void cancelWorker(const std::string& name, const bool wait = true) { workerManager_.cancelWorker(name, wait); }
 
+  /*!
+   * Change the scheduling policy and priority of a worker managed by the WorkerManager, also while it is running.
+   * @param name      Name of the worker
+   * @param priority  Priority within the range of the policy
+   * @param policy    Scheduling policy (SCHED_FIFO, SCHED_RR, SCHED_OTHER, SCHED_BATCH or SCHED_IDLE)
+   * @return          True if successful
+   */
+  inline bool setWorkerPriority(const std::string& name, const int priority, const int policy) {
+    return workerManager_.setWorkerPriority(name, priority, policy);
+  }
+
+  /*!
+   * Change the priority of a worker managed by the WorkerManager, keeping its current scheduling policy.
+   * @param name      Name of the worker
+   * @param priority  Priority within the range of the current policy of the worker
+   * @return          True if successful
+   */
+  inline bool setWorkerPriority(const std::string& name, const int priority) { return workerManager_.setWorkerPriority(name, priority); }
+
+  /*!
+   * Change the CPUs a worker managed by the WorkerManager may run on, also while it is running.
+   * @param name  Name of the worker
+   * @param cpus  CPUs, all CPUs if empty
+   * @return      True if successful
+   */
+  inline bool setWorkerCpuSet(const std::string& name, const std::vector<int>& cpus) { return workerManager_.setWorkerCpuSet(name, cpus); }
+
+  /*!
+   * Start publishing a heartbeat (see Heartbeat.hpp) from a worker with the time step given by the parameter heartbeat/time_step
+   * (heartbeat.time_step in ROS 2), no heartbeat is published if it is not positive. The publisher is named "heartbeat".
+   * The health bit of a worker is read from the parameter heartbeat/worker_bits/<worker> (heartbeat.worker_bits.<worker> in ROS 2, with
+   * the worker name sanitized as for the worker parameters) or assigned to the lowest free bit when the worker is first seen. The
+   * assignment is written back to that parameter, such that peers can look it up. Workers beyond 32 get no bit.
+   * Called by Nodewrap after init().
+   * @return      True if successful or disabled
+   */
+  bool startHeartbeat();
+
   /*!
    * Method to stop all workers managed by the WorkerManager
    */
@@ -117,6 +196,20 @@ class Node {
   inline ros::NodeHandle& getNodeHandle() const { return *nh_; }
 #else  /* ROS2_BUILD */
   inline rclcpp::Node& getNodeHandle() const { return *nh_; }
+
+  /*!
+   * Get a callback group configured in the executor parameters (see Executor), to be passed to the subscribe and service helpers.
+   * @param name  Name of the callback group
+   * @return      Callback group, nullptr (the default callback group) if it does not exist
+   */
+  rclcpp::CallbackGroup::SharedPtr getCallbackGroup(const std::string& name) const;
+
+  /*!
+   * Set the callback groups of the executor, called by Nodewrap before init().
+   */
+  inline void setCallbackGroups(std::map<std::string, rclcpp::CallbackGroup::SharedPtr> callbackGroups) {
+    callbackGroups_ = std::move(callbackGroups);
+  }
 #endif /* ROS2_BUILD */
 
   /*
@@ -164,9 +257,56 @@ class Node {
 #else  /* ROS2_BUILD */
                                                          uint32_t queue_size, void (T::*fp)(const std::shared_ptr<M const>&), T* obj) {
 #endif /* ROS2_BUILD */
+#ifndef ROS2_BUILD
+    return any_node::throttledSubscribe<M, T>(timeStep, *nh_, name, defaultTopic, queue_size, fp, obj, transport_hints);
+#else  /* ROS2_BUILD */
     return any_node::throttledSubscribe<M, T>(timeStep, *nh_, name, defaultTopic, queue_size, fp, obj);
+#endif /* ROS2_BUILD */
   }
 
+  /*
+   * subscribe and throttledSubscribe recording the statistics of the received messages
+   */
+  template <class M, class T>
+#ifndef ROS2_BUILD
+  inline ros::Subscriber subscribe(const std::string& name, const std::string& defaultTopic, uint32_t queue_size,
+                                   void (T::*fp)(const boost::shared_ptr<M const>&), T* obj, const SubscriberStatisticsPtr& statistics,
+                                   const ros::TransportHints& transport_hints = ros::TransportHints()) {
+    return any_node::subscribe(*nh_, name, defaultTopic, queue_size, fp, obj, statistics, transport_hints);
+  }
+#else  /* ROS2_BUILD */
+  inline typename rclcpp::Subscription<M>::SharedPtr subscribe(const std::string& name, const std::string& defaultTopic,
+                                                               uint32_t queue_size, void (T::*fp)(const std::shared_ptr<M const>&),
+                                                               T* obj, const SubscriberStatisticsPtr& statistics) {
+    return any_node::subscribe(*nh_, name, defaultTopic, queue_size, fp, obj, statistics);
+  }
+#endif /* ROS2_BUILD */
+
+  template <class M, class T>
+#ifndef ROS2_BUILD
+  inline ThrottledSubscriberPtr<M, T> throttledSubscribe(double timeStep, const std::string& name, const std::string& defaultTopic,
+                                                         uint32_t queue_size, void (T::*fp)(const boost::shared_ptr<M const>&), T* obj,
+                                                         const SubscriberStatisticsPtr& statistics,
+                                                         const ros::TransportHints& transport_hints = ros::TransportHints()) {
+    return any_node::throttledSubscribe<M, T>(timeStep, *nh_, name, defaultTopic, queue_size, fp, obj, statistics, transport_hints);
+  }
+#else  /* ROS2_BUILD */
+  inline ThrottledSubscriberPtr<M, T> throttledSubscribe(double timeStep, const std::string& name, const std::string& defaultTopic,
+                                                         uint32_t queue_size, void (T::*fp)(const std::shared_ptr<M const>&), T* obj,
+                                                         const SubscriberStatisticsPtr& statistics) {
+    return any_node::throttledSubscribe<M, T>(timeStep, *nh_, name, defaultTopic, queue_size, fp, obj, statistics);
+  }
+#endif /* ROS2_BUILD */
+
+#ifndef ROS2_BUILD
+  inline TopicRelayPtr relay(const std::string& subscriberName, const std::string& defaultSubscriberTopic, const std::string& publisherName,
+                             const std::string& defaultPublisherTopic, uint32_t queue_size, bool latch = false,
+                             unsigned int maxMessageBufferSize = 0, const ros::TransportHints& transport_hints = ros::TransportHints()) {
+    return any_node::relay(*nh_, subscriberName, defaultSubscriberTopic, publisherName, defaultPublisherTopic, queue_size, latch,
+                           maxMessageBufferSize, transport_hints);
+  }
+#endif /* ROS2_BUILD */
+
   template <class T, class MReq, class MRes>
 #ifndef ROS2_BUILD
   inline ros::ServiceServer advertiseService(const std::string& name, const std::string& defaultService, bool (T::*srv_func)(MReq&, MRes&),
@@ -177,6 +317,15 @@ class Node {
     return any_node::advertiseService(*nh_, name, defaultService, srv_func, obj);
   }
 
+#ifndef ROS2_BUILD
+  template <class T, class MReq, class MRes>
+  inline PooledServiceServerPtr<MReq, MRes> pooledAdvertiseService(const std::string& name, const std::string& defaultService,
+                                                                   bool (T::*srv_func)(MReq&, MRes&), T* obj, unsigned int numThreads = 1,
+                                                                   unsigned int maxQueueSize = 0) {
+    return any_node::pooledAdvertiseService(*nh_, name, defaultService, srv_func, obj, numThreads, maxQueueSize);
+  }
+#endif /* ROS2_BUILD */
+
 #ifndef ROS2_BUILD
   template <class MReq, class MRes>
   inline ros::ServiceClient serviceClient(const std::string& name, const std::string& defaultService,
@@ -199,6 +348,24 @@ class Node {
 #endif /* ROS2_BUILD */
   }
 
+#ifndef ROS2_BUILD
+  template <class Service>
+  inline AsyncServiceClientPtr<Service> asyncServiceClient(const std::string& name, const std::string& defaultService,
+                                                           unsigned int numThreads = 1, unsigned int maxQueueSize = 0,
+                                                           const ros::M_string& header_values = ros::M_string()) {
+    return any_node::asyncServiceClient<Service>(*nh_, name, defaultService, numThreads, maxQueueSize, header_values);
+  }
+
+  template <class Service>
+  inline CachingServiceClientPtr<Service> cachingServiceClient(const std::string& name, const std::string& defaultService,
+                                                               double timeToLive = 0.0, unsigned int maxCacheSize = 16,
+                                                               unsigned int numThreads = 1, unsigned int maxQueueSize = 0,
+                                                               const ros::M_string& header_values = ros::M_string()) {
+    return any_node::cachingServiceClient<Service>(*nh_, name, defaultService, timeToLive, maxCacheSize, numThreads, maxQueueSize,
+                                                   header_values);
+  }
+#endif /* ROS2_BUILD */
+
 #ifndef ROS2_BUILD
   /*
    * forwarding to Param.hpp functions
@@ -223,7 +390,30 @@ class Node {
   NodeHandlePtr nh_;
 
  private:
+  bool publishHeartbeat(const any_worker::WorkerEvent& event);
+
+  /*!
+   * Get the health bit of a worker, assigned on the first call.
+   * @return Bit, -1 if no bit is left.
+   */
+  int getHeartbeatBit(const std::string& workerName);
+
   any_worker::WorkerManager workerManager_;
+
+#ifndef ROS2_BUILD
+  ros::Publisher heartbeatPublisher_;
+#else  /* ROS2_BUILD */
+  rclcpp::Publisher<std_msgs::msg::UInt64>::SharedPtr heartbeatPublisher_;
+#endif /* ROS2_BUILD */
+  uint32_t heartbeatSequence_{0};
+  //! Number of rate errors of the workers at the previous heartbeat.
+  std::map<std::string, unsigned int> heartbeatNumRateErrors_;
+  //! Health bits by worker name, kept for removed workers such that the bits are not reused.
+  std::map<std::string, int> heartbeatBits_;
+
+#ifdef ROS2_BUILD
+  std::map<std::string, rclcpp::CallbackGroup::SharedPtr> callbackGroups_;
+#endif /* ROS2_BUILD */
 };
 
 }  // namespace any_node
@@ -17,7 +17,9 @@
 #include <memory>
 #include <mutex>
 
+#include "any_node/Executor.hpp"
 #include "any_node/Param.hpp"
+#include "any_node/RealtimeProfile.hpp"
 #include "any_worker/WorkerOptions.hpp"
 #ifndef ROS2_BUILD
 #include <message_logger/message_logger.hpp>
@@ -40,6 +42,7 @@ class Nodewrap {
    */
   Nodewrap(int argc, char** argv, const std::string& nodeName, int numSpinners = -1, const bool installSignalHandler = true)
       : signalHandlerInstalled_(installSignalHandler) {
+#ifndef ROS2_BUILD
     if (signalHandlerInstalled_) {
       ros::init(argc, argv, nodeName, ros::init_options::NoSigintHandler);
     } else {
@@ -51,25 +54,42 @@ class Nodewrap {
     // and https://github.com/ros/ros_comm/blob/noetic-devel/clients/roscpp/src/libros/node_handle.cpp#L194
     ros::start();
 
-#ifndef ROS2_BUILD
     nh_ = std::make_shared<ros::NodeHandle>("~");
-#else  /* ROS2_BUILD */
-    nh_ = std::make_shared<rclcpp::Node>("~");
-#endif /* ROS2_BUILD */
 
     if (numSpinners == -1) {
       numSpinners = param<unsigned int>(*nh_, "num_spinners", 2);
     }
 
     spinner_.reset(new ros::AsyncSpinner(numSpinners));
+    loadRealtimeProfile();
     impl_.reset(new NodeImpl(nh_));
+#else  /* ROS2_BUILD */
+    rclcpp::init(argc, argv, rclcpp::InitOptions(),
+                 signalHandlerInstalled_ ? rclcpp::SignalHandlerOptions::None : rclcpp::SignalHandlerOptions::All);
+
+    nh_ = std::make_shared<rclcpp::Node>(nodeName);
+
+    if (numSpinners == -1) {
+      numSpinners = 2;
+      getOptionalParameter(*nh_->get_node_parameters_interface(), "num_spinners", numSpinners);
+    }
+
+    executor_.reset(new Executor(nh_, static_cast<unsigned int>(numSpinners)));
+    loadRealtimeProfile();
+    impl_.reset(new NodeImpl(nh_));
+    impl_->setCallbackGroups(executor_->getCallbackGroups());
+#endif /* ROS2_BUILD */
 
     checkSteadyClock();
   }
 
   virtual ~Nodewrap() {
+#ifndef ROS2_BUILD
     // Call ros::shutdown here explicitly, as we also called ros::start explicitly in the constructor.
     ros::shutdown();
+#else  /* ROS2_BUILD */
+    rclcpp::shutdown();
+#endif /* ROS2_BUILD */
   };
 
   /*!
@@ -92,11 +112,24 @@ class Nodewrap {
       signal_handler::SignalHandler::bindAll(&Nodewrap::signalHandler, this);
     }
 
+    // The latency request is held until the workers are stopped in cleanup().
+    realtimeProfile_->check();
+    realtimeProfile_->acquire();
+
+#ifndef ROS2_BUILD
     spinner_->start();
     if (!impl_->init()) {
       MELO_ERROR("Failed to init Node %s!", ros::this_node::getName().c_str());
+#else  /* ROS2_BUILD */
+    executor_->start();
+    if (!impl_->init()) {
+      MELO_ERROR("Failed to init Node %s!", nh_->get_name());
+#endif /* ROS2_BUILD */
       return false;
     }
+    if (!impl_->startHeartbeat()) {
+      MELO_ERROR("Failed to start the heartbeat, the node runs without it.");
+    }
 
     running_ = true;
     return true;
@@ -121,7 +154,12 @@ class Nodewrap {
 
     impl_->preCleanup();
     impl_->stopAllWorkers();
+    realtimeProfile_->release();
+#ifndef ROS2_BUILD
     spinner_->stop();
+#else  /* ROS2_BUILD */
+    executor_->stop();
+#endif /* ROS2_BUILD */
     impl_->cleanup();
   }
 
@@ -156,14 +194,42 @@ class Nodewrap {
 
   NodeImpl* getImplPtr() { return impl_.get(); }
 
+  const RealtimeProfile& getRealtimeProfile() const { return *realtimeProfile_; }
+
  protected:
+  /*!
+   * Load the real-time profile from the parameters in the namespace realtime_profile, see RealtimeProfileOptions:
+   *  - cpu_dma_latency:    CPU latency in microseconds, -1 to not request it
+   *  - governor:           expected CPU frequency governor, e.g. performance
+   *  - isolated_cpus:      expected isolated CPUs, e.g. "2-3"
+   *  - check_irq_affinity: check that no interrupt is routed to the isolated CPUs
+   */
+  void loadRealtimeProfile() {
+    RealtimeProfileOptions options;
+#ifndef ROS2_BUILD
+    options.cpuDmaLatency_ = param<int>(*nh_, "realtime_profile/cpu_dma_latency", options.cpuDmaLatency_);
+    options.governor_ = param<std::string>(*nh_, "realtime_profile/governor", options.governor_);
+    options.isolatedCpus_ = param<std::string>(*nh_, "realtime_profile/isolated_cpus", options.isolatedCpus_);
+    options.checkIrqAffinity_ = param<bool>(*nh_, "realtime_profile/check_irq_affinity", options.checkIrqAffinity_);
+#else  /* ROS2_BUILD */
+    auto& parameterInterface = *nh_->get_node_parameters_interface();
+    getOptionalParameter(parameterInterface, "realtime_profile.cpu_dma_latency", options.cpuDmaLatency_);
+    getOptionalParameter(parameterInterface, "realtime_profile.governor", options.governor_);
+    getOptionalParameter(parameterInterface, "realtime_profile.isolated_cpus", options.isolatedCpus_);
+    getOptionalParameter(parameterInterface, "realtime_profile.check_irq_affinity", options.checkIrqAffinity_);
+#endif /* ROS2_BUILD */
+    realtimeProfile_ = std::make_unique<RealtimeProfile>(std::move(options));
+  }
+
 #ifndef ROS2_BUILD
   std::shared_ptr<ros::NodeHandle> nh_;
+  std::unique_ptr<ros::AsyncSpinner> spinner_;
 #else  /* ROS2_BUILD */
   std::shared_ptr<rclcpp::Node> nh_;
+  std::unique_ptr<Executor> executor_;
 #endif /* ROS2_BUILD */
-  std::unique_ptr<ros::AsyncSpinner> spinner_;
   std::unique_ptr<NodeImpl> impl_;
+  std::unique_ptr<RealtimeProfile> realtimeProfile_;
 
   bool signalHandlerInstalled_{false};
 
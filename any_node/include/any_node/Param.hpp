@@ -19,6 +19,36 @@ using namespace param_io;  // NOLINT
 
 #else
 
+#include <string>
+
 #include <acl_config/acl_config.hpp>
+#include <rclcpp/node_interfaces/node_parameters_interface.hpp>
+#include <rclcpp/parameter_value.hpp>
+
+namespace any_node {
+
+/*!
+ * Read a parameter if it is declared or given as override (e.g. in a parameter file or on the command line). Overrides are declared on
+ * the first read, such that they also reach nodes which do not declare their parameters from overrides automatically.
+ * @param parameterInterface Parameter interface of the node.
+ * @param name               Name of the parameter.
+ * @param value              Value, unchanged if the parameter is neither declared nor overridden.
+ * @return                   True if the parameter is declared or overridden.
+ */
+template <typename ParamT>
+bool getOptionalParameter(rclcpp::node_interfaces::NodeParametersInterface& parameterInterface, const std::string& name, ParamT& value) {
+  if (!parameterInterface.has_parameter(name)) {
+    const auto& overrides = parameterInterface.get_parameter_overrides();
+    const auto parameterOverride = overrides.find(name);
+    if (parameterOverride == overrides.end()) {
+      return false;
+    }
+    parameterInterface.declare_parameter(name, parameterOverride->second);
+  }
+  value = acl::config::getParameter<ParamT>(parameterInterface, name);
+  return true;
+}
+
+}  // namespace any_node
 
 #endif
@@ -0,0 +1,176 @@
+/*!
+ * @file    PooledServiceServer.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+#ifndef ROS2_BUILD
+
+// c++
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+// ros
+#include <ros/callback_queue_interface.h>
+#include <ros/ros.h>
+
+#include <any_worker/ThreadPool.hpp>
+#include <message_logger/message_logger.hpp>
+
+#include "any_node/LatencyHistogram.hpp"
+
+namespace any_node {
+
+/*!
+ * Service server whose requests are handled on a dedicated thread pool instead of the spinner threads of the node, such that slow
+ * requests do not delay the topic callbacks.
+ *
+ * The server acts as callback queue of its service: The incoming requests are queued to the pool and executed by at most numThreads
+ * threads concurrently. If the queue is full, the request is shed: It is answered immediately with a failure (the client's call returns
+ * false) without calling the handler.
+ * The latency (time from the reception of the request until the handler returned) and the handler duration are recorded per server.
+ */
+template <class MReq, class MRes>
+class PooledServiceServer : public ros::CallbackQueueInterface {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using Handler = std::function<bool(MReq&, MRes&)>;
+
+  /*!
+   * @param nh           Node handle.
+   * @param service      Service name.
+   * @param handler      Service handler, called concurrently from up to numThreads threads.
+   * @param numThreads   Number of requests handled concurrently.
+   * @param maxQueueSize Maximum number of requests waiting to be handled, 0 means unbounded. Requests exceeding it are shed.
+   */
+  PooledServiceServer(ros::NodeHandle& nh, const std::string& service, Handler handler, unsigned int numThreads = 1,
+                      unsigned int maxQueueSize = 0)
+      : service_(service), handler_(std::move(handler)), pool_("service_server:" + service, numThreads, maxQueueSize) {
+    ros::AdvertiseServiceOptions options;
+    options.template init<MReq, MRes>(service_, [this](MReq& request, MRes& response) { return handleRequest(request, response); });
+    options.callback_queue = this;
+    server_ = nh.advertiseService(options);
+  }
+
+  PooledServiceServer(const PooledServiceServer&) = delete;
+  PooledServiceServer& operator=(const PooledServiceServer&) = delete;
+
+  ~PooledServiceServer() override { shutdown(); }
+
+  /*!
+   * Stop advertising the service and handle the requests which are already queued.
+   */
+  void shutdown() {
+    server_.shutdown();
+    pool_.stop();
+  }
+
+  void addCallback(const ros::CallbackInterfacePtr& callback, uint64_t /*owner_id*/) override {
+    const auto receiveTime = Clock::now();
+    if (pool_.submit([this, callback, receiveTime]() { execute(callback, receiveTime, false); })) {
+      return;
+    }
+
+    // The callback answers the request, so it is executed right away with the handler bypassed.
+    MELO_WARN_THROTTLE(1.0, "Service server %s: Queue is full, shedding request.", service_.c_str());
+    execute(callback, receiveTime, true);
+  }
+
+  void removeByID(uint64_t /*owner_id*/) override {
+    // Queued requests are still answered, the pool is emptied on shutdown.
+  }
+
+  const std::string& getService() const { return service_; }
+
+  unsigned int getNumPendingRequests() const { return pool_.getQueueSize() + pool_.getNumActive(); }
+
+  unsigned int getNumRequests() const { return numRequests_; }
+  unsigned int getNumFailures() const { return numFailures_; }
+  unsigned int getNumRejected() const { return pool_.getNumRejected(); }
+
+  /*!
+   * @return Histogram of the time in seconds from the reception of a request until its handler returned, including the queuing.
+   */
+  LatencyHistogram getLatency() const {
+    std::lock_guard<std::mutex> lock(statisticsMutex_);
+    return latency_;
+  }
+
+  /*!
+   * @return Statistics of the handler duration in seconds.
+   */
+  RunningStatistics getHandlerDuration() const {
+    std::lock_guard<std::mutex> lock(statisticsMutex_);
+    return handlerDuration_;
+  }
+
+  void resetStatistics() {
+    std::lock_guard<std::mutex> lock(statisticsMutex_);
+    latency_.reset();
+    handlerDuration_.reset();
+  }
+
+ protected:
+  void execute(const ros::CallbackInterfacePtr& callback, const Clock::time_point& receiveTime, const bool shed) {
+    shedRequest_ = shed;
+    receiveTime_ = receiveTime;
+    if (callback->call() == ros::CallbackInterface::TryAgain && !shed) {
+      addCallback(callback, 0);
+    }
+    shedRequest_ = false;
+  }
+
+  bool handleRequest(MReq& request, MRes& response) {
+    if (shedRequest_) {
+      return false;
+    }
+
+    const auto startTime = Clock::now();
+    const bool success = handler_(request, response);
+    const auto endTime = Clock::now();
+
+    numRequests_++;
+    if (!success) {
+      numFailures_++;
+    }
+    std::lock_guard<std::mutex> lock(statisticsMutex_);
+    latency_.add(std::chrono::duration<double>(endTime - receiveTime_).count());
+    handlerDuration_.add(std::chrono::duration<double>(endTime - startTime).count());
+    return success;
+  }
+
+  //! State of the request which is executed by the current thread, passed from execute(..) to handleRequest(..).
+  static thread_local bool shedRequest_;
+  static thread_local Clock::time_point receiveTime_;
+
+  const std::string service_;
+  Handler handler_;
+  ros::ServiceServer server_;
+
+  std::atomic<unsigned int> numRequests_{0};
+  std::atomic<unsigned int> numFailures_{0};
+  mutable std::mutex statisticsMutex_;
+  LatencyHistogram latency_;
+  RunningStatistics handlerDuration_;
+
+  any_worker::ThreadPool pool_;
+};
+
+template <class MReq, class MRes>
+thread_local bool PooledServiceServer<MReq, MRes>::shedRequest_{false};
+
+template <class MReq, class MRes>
+thread_local typename PooledServiceServer<MReq, MRes>::Clock::time_point PooledServiceServer<MReq, MRes>::receiveTime_{};
+
+template <class MReq, class MRes>
+using PooledServiceServerPtr = std::shared_ptr<PooledServiceServer<MReq, MRes>>;
+
+}  // namespace any_node
+
+#endif /* ROS2_BUILD */
@@ -0,0 +1,117 @@
+/*!
+ * @file    QosParam.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+#ifdef ROS2_BUILD
+
+// c++
+#include <string>
+
+// ros
+#include <rclcpp/rclcpp.hpp>
+
+#include <message_logger/message_logger.hpp>
+
+#include "any_node/Param.hpp"
+
+namespace any_node {
+
+/*!
+ * Override a QoS profile with the parameters <prefix>.qos.* which are declared:
+ *  - reliability:               reliable, best_effort or system_default
+ *  - history:                   keep_last or keep_all
+ *  - depth:                     history depth for keep_last
+ *  - durability:                volatile, transient_local or system_default
+ *  - deadline:                  expected maximum period between messages in seconds
+ *  - lifespan:                  maximum age of published messages in seconds (publishers only)
+ *  - liveliness:                automatic, manual_by_topic or system_default
+ *  - liveliness_lease_duration: time in seconds after which an endpoint is considered not alive
+ * Invalid values are reported and ignored.
+ * @param nh     Node.
+ * @param prefix Parameter prefix of the endpoint, e.g. publishers.<name>.
+ * @param qos    Default profile.
+ * @return       Profile with the overrides applied.
+ */
+inline rclcpp::QoS getQosParameters(rclcpp::Node& nh, const std::string& prefix, rclcpp::QoS qos) {
+  auto& parameterInterface = *nh.get_node_parameters_interface();
+  const std::string qosPrefix = prefix + ".qos.";
+
+  std::string reliability;
+  if (getOptionalParameter(parameterInterface, qosPrefix + "reliability", reliability)) {
+    if (reliability == "reliable") {
+      qos.reliability(rclcpp::ReliabilityPolicy::Reliable);
+    } else if (reliability == "best_effort") {
+      qos.reliability(rclcpp::ReliabilityPolicy::BestEffort);
+    } else if (reliability == "system_default") {
+      qos.reliability(rclcpp::ReliabilityPolicy::SystemDefault);
+    } else {
+      MELO_WARN("Parameter %sreliability has invalid value '%s'.", qosPrefix.c_str(), reliability.c_str());
+    }
+  }
+
+  std::string history;
+  int depth = static_cast<int>(qos.depth());
+  const bool hasDepth = getOptionalParameter(parameterInterface, qosPrefix + "depth", depth);
+  if (getOptionalParameter(parameterInterface, qosPrefix + "history", history)) {
+    if (history == "keep_last") {
+      qos.keep_last(static_cast<size_t>(depth));
+    } else if (history == "keep_all") {
+      qos.keep_all();
+    } else {
+      MELO_WARN("Parameter %shistory has invalid value '%s'.", qosPrefix.c_str(), history.c_str());
+    }
+  } else if (hasDepth) {
+    qos.keep_last(static_cast<size_t>(depth));
+  }
+
+  std::string durability;
+  if (getOptionalParameter(parameterInterface, qosPrefix + "durability", durability)) {
+    if (durability == "volatile") {
+      qos.durability(rclcpp::DurabilityPolicy::Volatile);
+    } else if (durability == "transient_local") {
+      qos.durability(rclcpp::DurabilityPolicy::TransientLocal);
+    } else if (durability == "system_default") {
+      qos.durability(rclcpp::DurabilityPolicy::SystemDefault);
+    } else {
+      MELO_WARN("Parameter %sdurability has invalid value '%s'.", qosPrefix.c_str(), durability.c_str());
+    }
+  }
+
+  double deadline = 0.0;
+  if (getOptionalParameter(parameterInterface, qosPrefix + "deadline", deadline)) {
+    qos.deadline(rclcpp::Duration::from_seconds(deadline));
+  }
+
+  double lifespan = 0.0;
+  if (getOptionalParameter(parameterInterface, qosPrefix + "lifespan", lifespan)) {
+    qos.lifespan(rclcpp::Duration::from_seconds(lifespan));
+  }
+
+  std::string liveliness;
+  if (getOptionalParameter(parameterInterface, qosPrefix + "liveliness", liveliness)) {
+    if (liveliness == "automatic") {
+      qos.liveliness(rclcpp::LivelinessPolicy::Automatic);
+    } else if (liveliness == "manual_by_topic") {
+      qos.liveliness(rclcpp::LivelinessPolicy::ManualByTopic);
+    } else if (liveliness == "system_default") {
+      qos.liveliness(rclcpp::LivelinessPolicy::SystemDefault);
+    } else {
+      MELO_WARN("Parameter %sliveliness has invalid value '%s'.", qosPrefix.c_str(), liveliness.c_str());
+    }
+  }
+
+  double livelinessLeaseDuration = 0.0;
+  if (getOptionalParameter(parameterInterface, qosPrefix + "liveliness_lease_duration", livelinessLeaseDuration)) {
+    qos.liveliness_lease_duration(rclcpp::Duration::from_seconds(livelinessLeaseDuration));
+  }
+
+  return qos;
+}
+
+}  // namespace any_node
+
+#endif /* ROS2_BUILD */
@@ -0,0 +1,96 @@
+/*!
+ * @file    RealtimeProfile.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+// c++
+#include <string>
+#include <vector>
+
+namespace any_node {
+
+struct RealtimeProfileOptions {
+  /*!
+   * Maximum wake-up latency of the CPUs in microseconds, requested through /dev/cpu_dma_latency while the profile is acquired.
+   * 0 keeps the CPUs out of deep idle states. A negative value does not request a latency.
+   */
+  int cpuDmaLatency_{-1};
+
+  /*!
+   * Expected CPU frequency governor (e.g. "performance"), not checked if empty.
+   */
+  std::string governor_;
+
+  /*!
+   * CPUs expected to be isolated from the scheduler (isolcpus kernel parameter), in the kernel's CPU list format (e.g. "2-3,6").
+   * The governor is checked for these CPUs if given, otherwise for all online CPUs.
+   */
+  std::string isolatedCpus_;
+
+  /*!
+   * Check that no interrupt is routed to the isolated CPUs.
+   */
+  bool checkIrqAffinity_{false};
+};
+
+/*!
+ * Configures and checks the host for real-time workers:
+ *  - acquire() holds a PM QoS CPU latency request, which keeps the CPUs from entering idle states with a longer wake-up latency. The
+ *    kernel drops the request as soon as it is released or the process terminates.
+ *  - check() verifies the CPU frequency governor, the CPU isolation and the interrupt affinities and reports deviations.
+ */
+class RealtimeProfile {
+ public:
+  /*!
+   * @param options  Options.
+   * @param rootPath Path prepended to the paths in /dev, /proc and /sys.
+   */
+  explicit RealtimeProfile(RealtimeProfileOptions options, std::string rootPath = "");
+  RealtimeProfile(const RealtimeProfile&) = delete;
+  RealtimeProfile& operator=(const RealtimeProfile&) = delete;
+  virtual ~RealtimeProfile();
+
+  /*!
+   * Request the CPU latency, if configured.
+   * @return True if successful or no latency is configured.
+   */
+  bool acquire();
+
+  /*!
+   * Release the CPU latency request.
+   */
+  void release();
+
+  bool isAcquired() const { return cpuDmaLatencyFileDescriptor_ >= 0; }
+
+  /*!
+   * Check the host configuration and warn about deviations from the options.
+   * @return True if the configuration matches the options.
+   */
+  bool check() const;
+
+  const RealtimeProfileOptions& getOptions() const { return options_; }
+
+  /*!
+   * Parse a CPU list (e.g. "0-2,5").
+   * @param cpuList CPU list.
+   * @param cpus    Parsed CPUs.
+   * @return        True if successful.
+   */
+  static bool parseCpuList(const std::string& cpuList, std::vector<int>& cpus);
+
+ protected:
+  bool checkGovernor(const std::vector<int>& isolatedCpus) const;
+  bool checkIsolation(const std::vector<int>& isolatedCpus) const;
+  bool checkIrqAffinity(const std::vector<int>& isolatedCpus) const;
+  bool readFile(const std::string& path, std::string& content) const;
+
+  const RealtimeProfileOptions options_;
+  const std::string rootPath_;
+  int cpuDmaLatencyFileDescriptor_{-1};
+};
+
+}  // namespace any_node
@@ -0,0 +1,16 @@
+/*!
+ * @file    RunningStatistics.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+#include <any_worker/RunningStatistics.hpp>
+
+namespace any_node {
+
+//! The running statistics are shared with any_worker::Rate.
+using RunningStatistics = any_worker::RunningStatistics;
+
+}  // namespace any_node
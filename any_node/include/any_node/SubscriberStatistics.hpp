@@ -0,0 +1,174 @@
+/*!
+ * @file    SubscriberStatistics.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+// c++
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "any_node/LatencyTracer.hpp"
+#include "any_node/MessageStamp.hpp"
+#include "any_node/RunningStatistics.hpp"
+
+namespace any_node {
+
+/*!
+ * Statistics about the messages received by a subscriber, kept in constant memory:
+ *  - Receive rate and inter-arrival jitter (standard deviation of the time between two messages).
+ *  - Message age, which is the receive time minus the header stamp (only for messages with a header).
+ *  - Duration of the subscriber callback.
+ *  - Number of messages dropped by throttling.
+ * The statistics accumulate until reset() is called. If a latency tracer is given, the received messages are traced as its inputs.
+ * All methods are thread-safe.
+ */
+class SubscriberStatistics {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  explicit SubscriberStatistics(std::string name = "", LatencyTracerPtr latencyTracer = nullptr)
+      : name_(std::move(name)), latencyTracer_(std::move(latencyTracer)) {}
+
+  /*!
+   * Add a received message, computing its age from the header stamp.
+   * @param receiveTime Time of reception.
+   * @param msg         Received message.
+   */
+  template <typename MessageType>
+  void addMessage(const Clock::time_point& receiveTime, const MessageType& msg) {
+    const int64_t stamp = internal::getMessageStamp(msg);
+    if (stamp == 0) {
+      addMessage(receiveTime, std::numeric_limits<double>::quiet_NaN());
+      return;
+    }
+#ifndef ROS2_BUILD
+    const int64_t now = internal::getRosTimeNow();
+#else  /* ROS2_BUILD */
+    const int64_t now = internal::getRosTimeNow(clock_);
+#endif /* ROS2_BUILD */
+    addMessage(receiveTime, 1e-9 * static_cast<double>(now - stamp));
+    if (latencyTracer_) {
+      latencyTracer_->addInput(stamp, now, receiveTime);
+    }
+  }
+
+  /*!
+   * Add a received message.
+   * @param receiveTime Time of reception.
+   * @param age         Age of the message in seconds, NaN if unknown.
+   */
+  void addMessage(const Clock::time_point& receiveTime, const double age) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (numMessages_ > 0) {
+      interArrivalTime_.add(std::chrono::duration<double>(receiveTime - lastReceiveTime_).count());
+    }
+    numMessages_++;
+    lastReceiveTime_ = receiveTime;
+    age_.add(age);
+  }
+
+  /*!
+   * Add the duration of a subscriber callback.
+   * @param duration Callback duration in seconds.
+   */
+  void addCallbackDuration(const double duration) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    callbackDuration_.add(duration);
+  }
+
+  /*!
+   * Count a message which has been dropped before calling the callback.
+   */
+  void addDrop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    numDrops_++;
+  }
+
+  void reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    numMessages_ = 0;
+    numDrops_ = 0;
+    interArrivalTime_.reset();
+    age_.reset();
+    callbackDuration_.reset();
+  }
+
+  const std::string& getName() const { return name_; }
+
+  const LatencyTracerPtr& getLatencyTracer() const { return latencyTracer_; }
+
+#ifdef ROS2_BUILD
+  /*!
+   * Set the clock of the node, with which the age of the messages is computed. Has to be set before adding messages, the subscribe
+   * helpers set it.
+   */
+  void setClock(rclcpp::Clock::SharedPtr clock) { clock_ = std::move(clock); }
+#endif /* ROS2_BUILD */
+
+  unsigned int getNumMessages() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return numMessages_;
+  }
+
+  unsigned int getNumDrops() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return numDrops_;
+  }
+
+  /*!
+   * @return Mean receive rate in Hz, NaN if less than two messages were received.
+   */
+  double getRate() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return 1.0 / interArrivalTime_.getMean();
+  }
+
+  /*!
+   * @return Statistics of the time between two received messages in seconds. The standard deviation is the jitter.
+   */
+  RunningStatistics getInterArrivalTime() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return interArrivalTime_;
+  }
+
+  /*!
+   * @return Statistics of the message age in seconds.
+   */
+  RunningStatistics getAge() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return age_;
+  }
+
+  /*!
+   * @return Statistics of the callback duration in seconds.
+   */
+  RunningStatistics getCallbackDuration() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return callbackDuration_;
+  }
+
+ private:
+  const std::string name_;
+  const LatencyTracerPtr latencyTracer_;
+#ifdef ROS2_BUILD
+  rclcpp::Clock::SharedPtr clock_{internal::getDefaultRosClock()};
+#endif /* ROS2_BUILD */
+
+  mutable std::mutex mutex_;
+  unsigned int numMessages_{0};
+  unsigned int numDrops_{0};
+  Clock::time_point lastReceiveTime_{};
+  RunningStatistics interArrivalTime_;
+  RunningStatistics age_;
+  RunningStatistics callbackDuration_;
+};
+
+using SubscriberStatisticsPtr = std::shared_ptr<SubscriberStatistics>;
+
+}  // namespace any_node
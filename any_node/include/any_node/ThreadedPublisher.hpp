@@ -9,7 +9,9 @@
 // c++
 #include <atomic>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <thread>
 
@@ -24,22 +26,61 @@
 #include <message_logger/message_logger.hpp>
 #endif
 
+#include "any_node/LatencyTracer.hpp"
+#include "any_node/MessageRecorder.hpp"
+#include "any_node/MessageStamp.hpp"
+
 namespace any_node {
 
-template <typename MessageType>
+/*!
+ * Publisher which buffers the messages and publishes them from its own thread, such that publishing does not block the caller.
+ * @tparam MessageType   Type of the messages.
+ * @tparam PublisherType Type of the underlying publisher, only to be replaced for testing and benchmarking.
+ */
+#ifndef ROS2_BUILD
+template <typename MessageType, typename PublisherType = ros::Publisher>
+#else  /* ROS2_BUILD */
+template <typename MessageType, typename PublisherType = typename rclcpp::Publisher<MessageType>::SharedPtr>
+#endif /* ROS2_BUILD */
 class ThreadedPublisher {
  protected:
-  mutable std::mutex publisherMutex_;
 #ifndef ROS2_BUILD
-  ros::Publisher publisher_;
+  /*!
+   * Message in the buffer, either stored in place or shared with the caller, which is published without copying.
+   */
+  struct BufferedMessage {
+    explicit BufferedMessage(const MessageType& message) : message_(message) {}
+    explicit BufferedMessage(MessageType&& message) : message_(std::move(message)) {}
+    explicit BufferedMessage(boost::shared_ptr<const MessageType> sharedMessage) : sharedMessage_(std::move(sharedMessage)) {}
+
+    const MessageType& get() const { return sharedMessage_ ? *sharedMessage_ : *message_; }
+
+    std::optional<MessageType> message_;
+    boost::shared_ptr<const MessageType> sharedMessage_;
+  };
 #else  /* ROS2_BUILD */
-  typename rclcpp::Publisher<MessageType>::SharedPtr publisher_;
+  /*!
+   * Message in the buffer, either loaned from the middleware or allocated on the heap, which is handed to the publisher without copying.
+   */
+  struct BufferedMessage {
+    explicit BufferedMessage(std::unique_ptr<MessageType> message) : message_(std::move(message)) {}
+    explicit BufferedMessage(rclcpp::LoanedMessage<MessageType>&& loanedMessage) : loanedMessage_(std::move(loanedMessage)) {}
+
+    const MessageType& get() const { return loanedMessage_ ? loanedMessage_->get() : *message_; }
+
+    std::unique_ptr<MessageType> message_;
+    std::optional<rclcpp::LoanedMessage<MessageType>> loanedMessage_;
+  };
 #endif /* ROS2_BUILD */
 
+  mutable std::mutex publisherMutex_;
+  PublisherType publisher_;
+
   std::mutex messageBufferMutex_;
-  std::queue<MessageType> messageBuffer_;
+  std::queue<BufferedMessage> messageBuffer_;
   unsigned int maxMessageBufferSize_{0};
   bool autoPublishRos_{true};
+  std::atomic<unsigned int> numDroppedMessages_{0};
 
   std::thread thread_;
   std::mutex notifyThreadMutex_;
@@ -47,13 +88,18 @@ class ThreadedPublisher {
   std::atomic<bool> notifiedThread_{false};
   std::atomic<bool> shutdownRequested_{false};
 
- public:
-#ifndef ROS2_BUILD
-  explicit ThreadedPublisher(const ros::Publisher& publisher, unsigned int maxMessageBufferSize = 10, bool autoPublishRos = true)
-#else  /* ROS2_BUILD */
-  explicit ThreadedPublisher(const typename rclcpp::Publisher<MessageType>::SharedPtr& publisher, unsigned int maxMessageBufferSize = 10,
-                             bool autoPublishRos = true)
+  LatencyTracerPtr latencyTracer_;
+#ifdef ROS2_BUILD
+  rclcpp::Clock::SharedPtr clock_{internal::getDefaultRosClock()};
 #endif /* ROS2_BUILD */
+
+  MessageRecorderPtr recorder_;
+  //! Connection of the topic in the recorder, added with the first recorded message.
+  bool recorderConnectionAdded_{false};
+  uint32_t recorderConnectionId_{0};
+
+ public:
+  explicit ThreadedPublisher(const PublisherType& publisher, unsigned int maxMessageBufferSize = 10, bool autoPublishRos = true)
       : publisher_(publisher), maxMessageBufferSize_(maxMessageBufferSize), autoPublishRos_(autoPublishRos) {
     if (autoPublishRos_) {
       thread_ = std::thread(&ThreadedPublisher::threadedPublish, this);
@@ -64,12 +110,51 @@ class ThreadedPublisher {
 
 #ifndef ROS2_BUILD
   void publish(const boost::shared_ptr<MessageType>& message) { addMessageToBuffer(*message); }
+
+  /*!
+   * Publish a message without copying it, the buffer shares the message with the caller, which must not modify it anymore.
+   */
+  void publish(const boost::shared_ptr<const MessageType>& message) {
+    traceOutput(*message);
+    addToBuffer(message);
+  }
 #else  /* ROS2_BUILD */
   void publish(const std::shared_ptr<MessageType>& message) { addMessageToBuffer(*message); }
 #endif /* ROS2_BUILD */
 
   void publish(const MessageType& message) { addMessageToBuffer(message); }
 
+  /*!
+   * Publish a message without copying it into the buffer.
+   */
+  void publish(MessageType&& message) { addMessageToBuffer(std::move(message)); }
+
+#ifdef ROS2_BUILD
+  /*!
+   * Publish a message without copying it, the pointer is handed to the publisher.
+   */
+  void publish(std::unique_ptr<MessageType> message) {
+    traceOutput(*message);
+    addToBuffer(std::move(message));
+  }
+
+  /*!
+   * Publish a message borrowed with borrowLoanedMessage() without copying it.
+   */
+  void publish(rclcpp::LoanedMessage<MessageType>&& message) {
+    traceOutput(message.get());
+    addToBuffer(std::move(message));
+  }
+
+  /*!
+   * Borrow a message from the middleware, to be filled in place and passed to publish(..). If the middleware supports loaning (e.g.
+   * shared memory transports), the message is published without any copy.
+   */
+  rclcpp::LoanedMessage<MessageType> borrowLoanedMessage() { return publisher_->borrow_loaned_message(); }
+
+  bool canLoanMessages() const { return publisher_->can_loan_messages(); }
+#endif /* ROS2_BUILD */
+
   void shutdown() {
     // Prohibit shutting down twice.
     if (shutdownRequested_) {
@@ -102,39 +187,131 @@ class ThreadedPublisher {
     return publisher_.isLatched();
   }
 
+  //! Number of messages discarded because the buffer was full.
+  unsigned int getNumDroppedMessages() const { return numDroppedMessages_; }
+
+  /*!
+   * Trace the published messages as outputs of the given latency tracer. Has to be set before publishing.
+   */
+  void setLatencyTracer(LatencyTracerPtr latencyTracer) { latencyTracer_ = std::move(latencyTracer); }
+
+  const LatencyTracerPtr& getLatencyTracer() const { return latencyTracer_; }
+
+  /*!
+   * Record the published messages, stamped with the time of publishing. The messages are serialized on the publishing thread, hence
+   * recording does not delay the caller of publish(..) if auto publishing is enabled. Has to be set before publishing.
+   */
+  void setRecorder(MessageRecorderPtr recorder) { recorder_ = std::move(recorder); }
+
+  const MessageRecorderPtr& getRecorder() const { return recorder_; }
+
+#ifdef ROS2_BUILD
+  /*!
+   * Set the clock of the node, with which the messages are traced and recorded. Has to be set before publishing, threadedAdvertise(..)
+   * sets it.
+   */
+  void setClock(rclcpp::Clock::SharedPtr clock) { clock_ = std::move(clock); }
+#endif /* ROS2_BUILD */
+
   /*!
    * Send all messages in the buffer.
    */
   void sendRos() {
     // Publish all messages in the buffer; stop the thread in case of a shutdown.
     while (!shutdownRequested_) {
-      // Execute the publishing with a copied message object.
-      MessageType message;
-      {
-        std::lock_guard<std::mutex> messageBufferLock(messageBufferMutex_);
-        if (messageBuffer_.empty()) {
-          break;
-        }
-        message = messageBuffer_.front();
-        messageBuffer_.pop();
+      // Execute the publishing with the message object moved out of the buffer.
+      std::unique_lock<std::mutex> messageBufferLock(messageBufferMutex_);
+      if (messageBuffer_.empty()) {
+        break;
       }
+      BufferedMessage message(std::move(messageBuffer_.front()));
+      messageBuffer_.pop();
+      messageBufferLock.unlock();
       {
         std::lock_guard<std::mutex> publisherLock(publisherMutex_);
-        publisher_.publish(message);
+#ifndef ROS2_BUILD
+        publisher_.publish(message.get());
+        record(message.get());
+#else  /* ROS2_BUILD */
+        // Recorded before publishing, as the message is moved to the middleware.
+        record(message.get());
+        if (message.loanedMessage_) {
+          publisher_->publish(std::move(*message.loanedMessage_));
+        } else {
+          // Publishing a unique pointer allows the intra-process communication to hand the message over to a subscriber without copying.
+          publisher_->publish(std::move(message.message_));
+        }
+#endif /* ROS2_BUILD */
       }
     }
   }
 
  protected:
-  void addMessageToBuffer(const MessageType& message) {
+  /*!
+   * Record a message if a recorder is set. Has to be called with the publisher mutex locked.
+   */
+  void record(const MessageType& message) {
+    if (!recorder_) {
+      return;
+    }
+    if (!recorderConnectionAdded_) {
+#ifndef ROS2_BUILD
+      recorderConnectionId_ = recorder_->addConnection(publisher_.getTopic(), message);
+#else  /* ROS2_BUILD */
+      recorderConnectionId_ = recorder_->addConnection(publisher_->get_topic_name(), message);
+#endif /* ROS2_BUILD */
+      recorderConnectionAdded_ = true;
+    }
+#ifndef ROS2_BUILD
+    recorder_->record(recorderConnectionId_, internal::getRosTimeNow(), message);
+#else  /* ROS2_BUILD */
+    recorder_->record(recorderConnectionId_, internal::getRosTimeNow(clock_), message);
+#endif /* ROS2_BUILD */
+  }
+
+  template <typename Message>
+  void addMessageToBuffer(Message&& message) {
+    traceOutput(message);
+#ifndef ROS2_BUILD
+    addToBuffer(std::forward<Message>(message));
+#else  /* ROS2_BUILD */
+    if (publisher_->can_loan_messages()) {
+      // Loaned by the producer, such that the message is written to the memory of the middleware (e.g. shared memory) right away.
+      auto loanedMessage = publisher_->borrow_loaned_message();
+      loanedMessage.get() = std::forward<Message>(message);
+      addToBuffer(std::move(loanedMessage));
+    } else {
+      addToBuffer(std::make_unique<MessageType>(std::forward<Message>(message)));
+    }
+#endif /* ROS2_BUILD */
+  }
+
+  void traceOutput(const MessageType& message) {
+    if (latencyTracer_) {
+#ifndef ROS2_BUILD
+      latencyTracer_->traceOutput(message);
+#else  /* ROS2_BUILD */
+      latencyTracer_->traceOutput(message, clock_);
+#endif /* ROS2_BUILD */
+    }
+  }
+
+  /*!
+   * Construct a message in the buffer, discarding the oldest message if the buffer is full.
+   */
+  template <typename Message>
+  void addToBuffer(Message&& message) {
     {
       std::lock_guard<std::mutex> messageBufferLock(messageBufferMutex_);
       if (messageBuffer_.size() == maxMessageBufferSize_) {
-        MELO_ERROR_STREAM("Threaded publisher: Message buffer reached max size, discarding oldest message without publishing. Topic: "
-                          << publisher_.getTopic());
+        // Throttled, as printing every drop would slow down the caller even more.
+        MELO_ERROR_THROTTLE(1.0,
+                            "Threaded publisher: Message buffer reached max size, discarding oldest message without publishing. Topic: %s",
+                            publisher_.getTopic().c_str());
         messageBuffer_.pop();
+        numDroppedMessages_++;
       }
-      messageBuffer_.push(message);
+      messageBuffer_.emplace(std::forward<Message>(message));
     }
     notifyThread();
   }
@@ -9,20 +9,35 @@
 // STL
 #include <chrono>
 #include <functional>
+#include <limits>
 
 // ros
 #ifndef ROS2_BUILD
 #include <ros/ros.h>
+#include <topic_tools/shape_shifter.h>
 #else /* ROS2_BUILD */
 #include "rclcpp/rclcpp.hpp"
+#include "rclcpp/serialization.hpp"
 #endif /* ROS2_BUILD */
 
 #ifndef ROS2_BUILD
 #include <message_logger/message_logger.hpp>
 #endif
 
+#include "any_node/SubscriberStatistics.hpp"
+
 namespace any_node {
 
+/*!
+ * Subscriber which forwards at most one message per time step to the callback and drops the others.
+ *
+ * With lazy deserialization, the subscriber receives the serialized message, takes the throttling decision first and only deserializes
+ * the accepted messages. This saves the deserialization of all dropped messages, which is worth it for large messages (e.g. point
+ * clouds) and high throttling ratios.
+ *
+ * If statistics are given, all received messages and the dropped ones are counted. With lazy deserialization, the age is only known for
+ * the accepted messages.
+ */
 template <typename MessageType, typename CallbackClass>
 class ThrottledSubscriber {
  public:
@@ -31,21 +46,41 @@ class ThrottledSubscriber {
 #ifndef ROS2_BUILD
   ThrottledSubscriber(const double timeStep, ros::NodeHandle& nh, const std::string& topic, uint32_t queue_size,
                       void (CallbackClass::*fp)(const boost::shared_ptr<MessageType const>&), CallbackClass* obj,
-                      const ros::TransportHints& transport_hints = ros::TransportHints())
+                      const ros::TransportHints& transport_hints = ros::TransportHints(), const bool lazyDeserialization = false,
+                      SubscriberStatisticsPtr statistics = nullptr)
 #else  /* ROS2_BUILD */
-  ThrottledSubscriber(const double timeStep, rclcpp::Node& nh, const std::string& topic, uint32_t queue_size,
-                      void (CallbackClass::*fp)(const std::shared_ptr<MessageType const>&), CallbackClass* obj)
+  ThrottledSubscriber(const double timeStep, rclcpp::Node& nh, const std::string& topic, const rclcpp::QoS& qos,
+                      void (CallbackClass::*fp)(const std::shared_ptr<MessageType const>&), CallbackClass* obj,
+                      const bool lazyDeserialization = false, SubscriberStatisticsPtr statistics = nullptr)
 #endif /* ROS2_BUILD */
 #ifndef ROS2_BUILD
-      : fp_(fp), obj_(obj), lastTime_(ros::TIME_MIN), timeStep_(ros::Duration().fromSec(timeStep)) {
+      : fp_(fp), obj_(obj), lastTime_(ros::TIME_MIN), timeStep_(ros::Duration().fromSec(timeStep)), statistics_(std::move(statistics)) {
 #else  /* ROS2_BUILD */
-      : fp_(fp), obj_(obj), lastTime_(), timeStep_(rclcpp::Duration(std::chrono::seconds{timeStep})) {
+      : fp_(fp),
+        obj_(obj),
+        lastTime_(0, 0, nh.get_clock()->get_clock_type()),
+        timeStep_(rclcpp::Duration::from_seconds(timeStep)),
+        clock_(nh.get_clock()),
+        statistics_(std::move(statistics)) {
+    if (statistics_) {
+      statistics_->setClock(clock_);
+    }
 #endif /* ROS2_BUILD */
-    subscriber_ =
 #ifndef ROS2_BUILD
-        nh.subscribe(topic, queue_size, &ThrottledSubscriber<MessageType, CallbackClass>::internalCallback, this, transport_hints);
+    if (lazyDeserialization) {
+      subscriber_ = nh.subscribe(topic, queue_size, &ThrottledSubscriber<MessageType, CallbackClass>::internalSerializedCallback, this,
+                                 transport_hints);
+    } else {
+      subscriber_ =
+          nh.subscribe(topic, queue_size, &ThrottledSubscriber<MessageType, CallbackClass>::internalCallback, this, transport_hints);
+    }
 #else  /* ROS2_BUILD */
-        nh.create_subscription(topic, queue_size, &ThrottledSubscriber<MessageType, CallbackClass>::internalCallback, this);
+    if (lazyDeserialization) {
+      subscriber_ = nh.create_subscription<MessageType>(
+          topic, qos, [this](const std::shared_ptr<const rclcpp::SerializedMessage> msg) { internalSerializedCallback(msg); });
+    } else {
+      subscriber_ = nh.create_subscription(topic, qos, &ThrottledSubscriber<MessageType, CallbackClass>::internalCallback, this);
+    }
 #endif /* ROS2_BUILD */
   }
 
@@ -53,20 +88,93 @@ class ThrottledSubscriber {
 
   void shutdown() { subscriber_.shutdown(); }
 
+  const SubscriberStatisticsPtr& getStatistics() const { return statistics_; }
+
 #ifndef ROS2_BUILD
   void internalCallback(const boost::shared_ptr<MessageType const>& msg) {
-    ros::Time now = ros::Time::now();
 #else  /* ROS2_BUILD */
   void internalCallback(const std::shared_ptr<MessageType const>& msg) {
-    rclcpp::Time now = rclcpp::Clock{RCL_ROS_TIME}.now();
 #endif /* ROS2_BUILD */
-    if ((now - lastTime_) >= timeStep_) {
+    const auto receiveTime = SubscriberStatistics::Clock::now();
+    if (statistics_) {
+      statistics_->addMessage(receiveTime, *msg);
+    }
+    if (acceptMessage()) {
       (*obj_.*fp_)(msg);
-      lastTime_ = now;
+      addCallbackDuration(receiveTime);
     }
   }
 
+#ifndef ROS2_BUILD
+  void internalSerializedCallback(const boost::shared_ptr<topic_tools::ShapeShifter const>& serializedMsg) {
+    // The shape shifter accepts any type, reject the messages which a typed subscriber would not connect to instead of throwing.
+    if (serializedMsg->getMD5Sum() != ros::message_traits::MD5Sum<MessageType>::value()) {
+      if (!typeMismatchReported_) {
+        MELO_ERROR("Throttled subscriber on %s: Received messages of type %s (md5 %s) instead of %s (md5 %s), dropping them.",
+                   subscriber_.getTopic().c_str(), serializedMsg->getDataType().c_str(), serializedMsg->getMD5Sum().c_str(),
+                   ros::message_traits::DataType<MessageType>::value(), ros::message_traits::MD5Sum<MessageType>::value());
+        typeMismatchReported_ = true;
+      }
+      return;
+    }
+    const auto receiveTime = SubscriberStatistics::Clock::now();
+    if (acceptMessage()) {
+      const boost::shared_ptr<MessageType const> msg = serializedMsg->instantiate<MessageType>();
+      if (statistics_) {
+        statistics_->addMessage(receiveTime, *msg);
+      }
+      const auto callbackStartTime = SubscriberStatistics::Clock::now();
+      (*obj_.*fp_)(msg);
+      addCallbackDuration(callbackStartTime);
+    } else if (statistics_) {
+      statistics_->addMessage(receiveTime, std::numeric_limits<double>::quiet_NaN());
+    }
+  }
+#else  /* ROS2_BUILD */
+  void internalSerializedCallback(const std::shared_ptr<const rclcpp::SerializedMessage>& serializedMsg) {
+    const auto receiveTime = SubscriberStatistics::Clock::now();
+    if (acceptMessage()) {
+      auto msg = std::make_shared<MessageType>();
+      serialization_.deserialize_message(serializedMsg.get(), msg.get());
+      if (statistics_) {
+        statistics_->addMessage(receiveTime, *msg);
+      }
+      const auto callbackStartTime = SubscriberStatistics::Clock::now();
+      (*obj_.*fp_)(msg);
+      addCallbackDuration(callbackStartTime);
+    } else if (statistics_) {
+      statistics_->addMessage(receiveTime, std::numeric_limits<double>::quiet_NaN());
+    }
+  }
+#endif /* ROS2_BUILD */
+
  protected:
+  /*!
+   * Takes the throttling decision for a message received now.
+   * @return True if the message shall be forwarded to the callback.
+   */
+  bool acceptMessage() {
+#ifndef ROS2_BUILD
+    ros::Time now = ros::Time::now();
+#else  /* ROS2_BUILD */
+    rclcpp::Time now = clock_->now();
+#endif /* ROS2_BUILD */
+    if ((now - lastTime_) >= timeStep_) {
+      lastTime_ = now;
+      return true;
+    }
+    if (statistics_) {
+      statistics_->addDrop();
+    }
+    return false;
+  }
+
+  void addCallbackDuration(const SubscriberStatistics::Clock::time_point& callbackStartTime) {
+    if (statistics_) {
+      statistics_->addCallbackDuration(std::chrono::duration<double>(SubscriberStatistics::Clock::now() - callbackStartTime).count());
+    }
+  }
+
 #ifndef ROS2_BUILD
   ros::Subscriber subscriber_;
   void (CallbackClass::*fp_)(const boost::shared_ptr<MessageType const>&);
@@ -78,10 +186,15 @@ class ThrottledSubscriber {
 #ifndef ROS2_BUILD
   ros::Time lastTime_;
   ros::Duration timeStep_;
+  bool typeMismatchReported_{false};
 #else  /* ROS2_BUILD */
   rclcpp::Time lastTime_;
   rclcpp::Duration timeStep_;
+  //! Clock of the node, such that the throttling follows simulated time.
+  rclcpp::Clock::SharedPtr clock_;
+  rclcpp::Serialization<MessageType> serialization_;
 #endif /* ROS2_BUILD */
+  SubscriberStatisticsPtr statistics_;
 };
 
 template <typename MessageType, typename CallbackClass>
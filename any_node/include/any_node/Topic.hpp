@@ -15,17 +15,61 @@
 #include <ros/service_client.h>
 #include <ros/service_server.h>
 #include <ros/subscriber.h>
+
+#include <message_logger/message_logger.hpp>
 #else
 #include <acl_config/acl_config.hpp>
 #include <rclcpp/rclcpp.hpp>
 #endif
 
+#include "any_node/AsyncServiceClient.hpp"
+#include "any_node/CachingServiceClient.hpp"
 #include "any_node/Param.hpp"
+#include "any_node/PooledServiceServer.hpp"
+#include "any_node/QosParam.hpp"
+#include "any_node/SubscriberStatistics.hpp"
 #include "any_node/ThreadedPublisher.hpp"
 #include "any_node/ThrottledSubscriber.hpp"
+#include "any_node/TopicRelay.hpp"
 
 namespace any_node {
 
+namespace internal {
+
+/*!
+ * Wraps a subscriber callback to record the subscriber statistics.
+ */
+template <class MsgPtr, class T>
+auto makeInstrumentedCallback(void (T::*fp)(const MsgPtr&), T* obj, SubscriberStatisticsPtr statistics) {
+  return [fp, obj, statistics = std::move(statistics)](const MsgPtr& msg) {
+    const auto receiveTime = SubscriberStatistics::Clock::now();
+    statistics->addMessage(receiveTime, *msg);
+    (obj->*fp)(msg);
+    statistics->addCallbackDuration(std::chrono::duration<double>(SubscriberStatistics::Clock::now() - receiveTime).count());
+  };
+}
+
+#ifndef ROS2_BUILD
+/*!
+ * Read a count from an int parameter, values below the minimum are clamped to it.
+ * @param nh           Node handle.
+ * @param key          Parameter name.
+ * @param defaultValue Value used if the parameter is not set.
+ * @param minValue     Minimum value.
+ * @return             Count.
+ */
+inline unsigned int countParam(ros::NodeHandle& nh, const std::string& key, const unsigned int defaultValue, const unsigned int minValue) {
+  const int value = param<int>(nh, key, static_cast<int>(defaultValue));
+  if (value < static_cast<int>(minValue)) {
+    MELO_WARN("Parameter %s has invalid value %d, using %u instead.", nh.resolveName(key).c_str(), value, minValue);
+    return minValue;
+  }
+  return static_cast<unsigned int>(value);
+}
+#endif /* ROS2_BUILD */
+
+}  // namespace internal
+
 template <typename msg>
 #ifndef ROS2_BUILD
 ros::Publisher advertise(ros::NodeHandle& nh, const std::string& name, const std::string& defaultTopic, uint32_t queue_size,
@@ -52,7 +96,21 @@ typename rclcpp::Publisher<msg>::SharedPtr advertise(rclcpp::Node& nh, const std
     qos_profile.reliability(rclcpp::ReliabilityPolicy::Reliable);
   }
 
-  return nh.create_publisher<msg>(topic, qos_profile);
+  qos_profile = getQosParameters(nh, "publishers." + name, qos_profile);
+
+  // Intra-process communication hands messages published as unique pointers over to subscribers in the same process without copying them.
+  rclcpp::PublisherOptions options;
+  bool intraProcess = false;
+  if (getOptionalParameter(*parameterInterface, "publishers." + name + ".intra_process", intraProcess) && intraProcess) {
+    if (qos_profile.durability() == rclcpp::DurabilityPolicy::Volatile) {
+      options.use_intra_process_comm = rclcpp::IntraProcessSetting::Enable;
+    } else {
+      MELO_WARN("Publisher %s: Intra-process communication requires volatile durability, disabling it.", name.c_str());
+      options.use_intra_process_comm = rclcpp::IntraProcessSetting::Disable;
+    }
+  }
+
+  return nh.create_publisher<msg>(topic, qos_profile, options);
 #endif /* ROS2_BUILD */
 }
 
@@ -63,8 +121,12 @@ ThreadedPublisherPtr<msg> threadedAdvertise(ros::NodeHandle& nh, const std::stri
 ThreadedPublisherPtr<msg> threadedAdvertise(rclcpp::Node& nh, const std::string& name, const std::string& defaultTopic,
 #endif /* ROS2_BUILD */
                                             uint32_t queue_size, bool latch = false, unsigned int maxMessageBufferSize = 10) {
-  return ThreadedPublisherPtr<msg>(
+  ThreadedPublisherPtr<msg> publisher(
       new ThreadedPublisher<msg>(advertise<msg>(nh, name, defaultTopic, queue_size, latch), maxMessageBufferSize));
+#ifdef ROS2_BUILD
+  publisher->setClock(nh.get_clock());
+#endif /* ROS2_BUILD */
+  return publisher;
 }
 
 template <class M, class T>
@@ -92,20 +154,84 @@ typename rclcpp::Subscription<M>::SharedPtr subscribe(rclcpp::Node& nh, const st
   auto queueSize = acl::config::getParameter<int>(*parameterInterface, "subscribers." + name + ".queue_size");
   rclcpp::SubscriptionOptions options;
   options.callback_group = group;
-  return nh.create_subscription(topic, queueSize, std::bind(fp, obj, std::placeholders::_1), options);
+  return nh.create_subscription(topic, getQosParameters(nh, "subscribers." + name, rclcpp::QoS(rclcpp::KeepLast(queueSize))),
+                                std::bind(fp, obj, std::placeholders::_1), options);
 #endif /* ROS2_BUILD */
 }
 
+/*!
+ * Same as above, additionally recording the statistics of the received messages in the given object (if not null).
+ */
+template <class M, class T>
+#ifndef ROS2_BUILD
+ros::Subscriber subscribe(ros::NodeHandle& nh, const std::string& name, const std::string& defaultTopic, uint32_t queue_size,
+                          void (T::*fp)(const boost::shared_ptr<M const>&), T* obj, const SubscriberStatisticsPtr& statistics,
+                          const ros::TransportHints& transport_hints = ros::TransportHints()) {
+  if (!statistics) {
+    return subscribe(nh, name, defaultTopic, queue_size, fp, obj, transport_hints);
+  }
+  if (nh.param<bool>("subscribers/" + name + "/deactivate", false)) {
+    return ros::Subscriber();  // return empty subscriber
+  } else {
+    return nh.subscribe<M>(param<std::string>(nh, "subscribers/" + name + "/topic", defaultTopic),
+                           param<int>(nh, "subscribers/" + name + "/queue_size", queue_size),
+                           boost::function<void(const boost::shared_ptr<M const>&)>(
+                               internal::makeInstrumentedCallback(fp, obj, statistics)),
+                           ros::VoidConstPtr(), transport_hints);
+  }
+}
+#else  /* ROS2_BUILD */
+typename rclcpp::Subscription<M>::SharedPtr subscribe(rclcpp::Node& nh, const std::string& name, const std::string& defaultTopic,
+                                                      uint32_t queue_size, void (T::*fp)(const std::shared_ptr<M const>&), T* obj,
+                                                      const SubscriberStatisticsPtr& statistics,
+                                                      rclcpp::CallbackGroup::SharedPtr group = nullptr) {
+  if (!statistics) {
+    return subscribe(nh, name, defaultTopic, queue_size, fp, obj, group);
+  }
+  auto parameterInterface{nh.get_node_parameters_interface()};
+
+  auto topic = acl::config::getParameter<std::string>(*parameterInterface, "subscribers." + name + ".topic");
+  auto queueSize = acl::config::getParameter<int>(*parameterInterface, "subscribers." + name + ".queue_size");
+  rclcpp::SubscriptionOptions options;
+  options.callback_group = group;
+  if (statistics) {
+    statistics->setClock(nh.get_clock());
+  }
+  return nh.create_subscription<M>(topic, getQosParameters(nh, "subscribers." + name, rclcpp::QoS(rclcpp::KeepLast(queueSize))),
+                                   internal::makeInstrumentedCallback(fp, obj, statistics), options);
+}
+#endif /* ROS2_BUILD */
+
 template <class M, class T>
 #ifndef ROS2_BUILD
 ThrottledSubscriberPtr<M, T> throttledSubscribe(double timeStep, ros::NodeHandle& nh, const std::string& name,
                                                 const std::string& defaultTopic, uint32_t queue_size,
                                                 void (T::*fp)(const boost::shared_ptr<M const>&), T* obj,
                                                 const ros::TransportHints& transport_hints = ros::TransportHints()) {
+  return throttledSubscribe(timeStep, nh, name, defaultTopic, queue_size, fp, obj, SubscriberStatisticsPtr(), transport_hints);
+}
 #else  /* ROS2_BUILD */
 ThrottledSubscriberPtr<M, T> throttledSubscribe(double timeStep, rclcpp::Node& nh, const std::string& name,
                                                 [[deprecated]] const std::string& defaultTopic, [[deprecated]] uint32_t queue_size,
                                                 void (T::*fp)(const std::shared_ptr<M const>&), T* obj) {
+  return throttledSubscribe(timeStep, nh, name, defaultTopic, queue_size, fp, obj, SubscriberStatisticsPtr());
+}
+#endif /* ROS2_BUILD */
+
+/*!
+ * Same as above, additionally recording the statistics of the received and dropped messages in the given object (if not null).
+ */
+template <class M, class T>
+#ifndef ROS2_BUILD
+ThrottledSubscriberPtr<M, T> throttledSubscribe(double timeStep, ros::NodeHandle& nh, const std::string& name,
+                                                const std::string& defaultTopic, uint32_t queue_size,
+                                                void (T::*fp)(const boost::shared_ptr<M const>&), T* obj,
+                                                const SubscriberStatisticsPtr& statistics,
+                                                const ros::TransportHints& transport_hints = ros::TransportHints()) {
+#else  /* ROS2_BUILD */
+ThrottledSubscriberPtr<M, T> throttledSubscribe(double timeStep, rclcpp::Node& nh, const std::string& name, const std::string& defaultTopic,
+                                                uint32_t queue_size, void (T::*fp)(const std::shared_ptr<M const>&), T* obj,
+                                                const SubscriberStatisticsPtr& statistics) {
 #endif /* ROS2_BUILD */
 #ifndef ROS2_BUILD
   if (nh.param<bool>("subscribers/" + name + "/deactivate", false)) {
@@ -119,21 +245,64 @@ ThrottledSubscriberPtr<M, T> throttledSubscribe(double timeStep, rclcpp::Node& n
     return ThrottledSubscriberPtr<M, T>(
 #ifndef ROS2_BUILD
         new ThrottledSubscriber<M, T>(timeStep, nh, param<std::string>(nh, "subscribers/" + name + "/topic", defaultTopic),
-                                      param<int>(nh, "subscribers/" + name + "/queue_size", queue_size), fp, obj, transport_hints));
+                                      param<int>(nh, "subscribers/" + name + "/queue_size", queue_size), fp, obj, transport_hints,
+                                      nh.param<bool>("subscribers/" + name + "/lazy_deserialization", false), statistics));
 #else  /* ROS2_BUILD */
         new ThrottledSubscriber<M, T>(timeStep, nh,
                                       acl::config::getParameter<std::string>(paramInterface, "subscribers." + name + ".topic"),
-                                      acl::config::getParameter<int>(paramInterface, "subscribers." + name + ".queue_size"), fp, obj));
+                                      getQosParameters(nh, "subscribers." + name,
+                                                       rclcpp::QoS(rclcpp::KeepLast(acl::config::getParameter<int>(
+                                                           paramInterface, "subscribers." + name + ".queue_size")))),
+                                      fp, obj,
+                                      paramInterface.has_parameter("subscribers." + name + ".lazy_deserialization") &&
+                                          acl::config::getParameter<bool>(paramInterface, "subscribers." + name + ".lazy_deserialization"),
+                                      statistics));
 #endif /* ROS2_BUILD */
   }
 }
 
 #ifndef ROS2_BUILD
+/*!
+ * Forwards the messages of the subscriber to the publisher without decoding them. The connection details are read from the
+ * subscribers/<subscriberName> and publishers/<publisherName> parameters.
+ * @param maxMessageBufferSize  If larger than 0, the messages are published through a ThreadedPublisher with this buffer size.
+ * @return                      Relay, empty if the subscriber is deactivated.
+ */
+inline TopicRelayPtr relay(ros::NodeHandle& nh, const std::string& subscriberName, const std::string& defaultSubscriberTopic,
+                           const std::string& publisherName, const std::string& defaultPublisherTopic, uint32_t queue_size,
+                           bool latch = false, unsigned int maxMessageBufferSize = 0,
+                           const ros::TransportHints& transport_hints = ros::TransportHints()) {
+  if (nh.param<bool>("subscribers/" + subscriberName + "/deactivate", false)) {
+    return TopicRelayPtr(new TopicRelay());  // return empty relay
+  }
+  return TopicRelayPtr(new TopicRelay(nh, param<std::string>(nh, "subscribers/" + subscriberName + "/topic", defaultSubscriberTopic),
+                                      param<int>(nh, "subscribers/" + subscriberName + "/queue_size", queue_size),
+                                      param<std::string>(nh, "publishers/" + publisherName + "/topic", defaultPublisherTopic),
+                                      param<int>(nh, "publishers/" + publisherName + "/queue_size", queue_size),
+                                      param<bool>(nh, "publishers/" + publisherName + "/latch", latch), maxMessageBufferSize,
+                                      transport_hints));
+}
+
 template <class T, class MReq, class MRes>
 ros::ServiceServer advertiseService(ros::NodeHandle& nh, const std::string& name, const std::string& defaultService,
                                     bool (T::*srv_func)(MReq&, MRes&), T* obj) {
   return nh.advertiseService(param<std::string>(nh, "servers/" + name + "/service", defaultService), srv_func, obj);
 }
+
+/*!
+ * Advertise a service whose requests are handled on a dedicated thread pool instead of the spinner threads. The parameters
+ * servers/<name>/{service,num_threads,max_queue_size} override the given defaults.
+ */
+template <class T, class MReq, class MRes>
+PooledServiceServerPtr<MReq, MRes> pooledAdvertiseService(ros::NodeHandle& nh, const std::string& name, const std::string& defaultService,
+                                                          bool (T::*srv_func)(MReq&, MRes&), T* obj, unsigned int numThreads = 1,
+                                                          unsigned int maxQueueSize = 0) {
+  return std::make_shared<PooledServiceServer<MReq, MRes>>(
+      nh, param<std::string>(nh, "servers/" + name + "/service", defaultService),
+      [srv_func, obj](MReq& request, MRes& response) { return (obj->*srv_func)(request, response); },
+      internal::countParam(nh, "servers/" + name + "/num_threads", numThreads, 1),
+      internal::countParam(nh, "servers/" + name + "/max_queue_size", maxQueueSize, 0));
+}
 #else  /* ROS2_BUILD */
 template <class T, class Service>
 auto advertiseService(rclcpp::Node& nh, const std::string& name, const std::string& defaultService,
@@ -173,4 +342,36 @@ auto serviceClient(rclcpp::Node& nh, const std::string& name, const std::string&
 #endif /* ROS2_BUILD */
 }
 
+#ifndef ROS2_BUILD
+/*!
+ * Create a service client executing the calls on its own thread pool. The parameters clients/<name>/{service,persistent,num_threads,
+ * max_queue_size} override the given defaults.
+ */
+template <class Service>
+AsyncServiceClientPtr<Service> asyncServiceClient(ros::NodeHandle& nh, const std::string& name, const std::string& defaultService,
+                                                  unsigned int numThreads = 1, unsigned int maxQueueSize = 0,
+                                                  const ros::M_string& header_values = ros::M_string()) {
+  return std::make_shared<AsyncServiceClient<Service>>(
+      nh, param<std::string>(nh, "clients/" + name + "/service", defaultService), param<bool>(nh, "clients/" + name + "/persistent", false),
+      internal::countParam(nh, "clients/" + name + "/num_threads", numThreads, 1),
+      internal::countParam(nh, "clients/" + name + "/max_queue_size", maxQueueSize, 0), header_values);
+}
+
+/*!
+ * Create a service client for idempotent services, which coalesces identical requests in flight and caches successful responses. The
+ * parameters clients/<name>/{cache_time_to_live,cache_size} override the given defaults, the client is created with
+ * asyncServiceClient(..).
+ */
+template <class Service>
+CachingServiceClientPtr<Service> cachingServiceClient(ros::NodeHandle& nh, const std::string& name, const std::string& defaultService,
+                                                      double timeToLive = 0.0, unsigned int maxCacheSize = 16,
+                                                      unsigned int numThreads = 1, unsigned int maxQueueSize = 0,
+                                                      const ros::M_string& header_values = ros::M_string()) {
+  return std::make_shared<CachingServiceClient<Service>>(
+      asyncServiceClient<Service>(nh, name, defaultService, numThreads, maxQueueSize, header_values),
+      param<double>(nh, "clients/" + name + "/cache_time_to_live", timeToLive),
+      internal::countParam(nh, "clients/" + name + "/cache_size", maxCacheSize, 0));
+}
+#endif /* ROS2_BUILD */
+
 }  // namespace any_node
@@ -0,0 +1,110 @@
+/*!
+ * @file    TopicRelay.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+#ifndef ROS2_BUILD
+
+// c++
+#include <memory>
+#include <mutex>
+#include <string>
+
+// ros
+#include <ros/ros.h>
+#include <topic_tools/shape_shifter.h>
+
+#include <message_logger/message_logger.hpp>
+
+#include "any_node/ThreadedPublisher.hpp"
+
+namespace any_node {
+
+/*!
+ * Relay forwarding the serialized messages of one topic to another topic without decoding them.
+ * The output topic is advertised with the type of the first received message. If a message buffer size is given, the messages are
+ * published through a ThreadedPublisher, otherwise directly from the subscriber callback.
+ */
+class TopicRelay {
+ public:
+  TopicRelay() = default;
+
+  TopicRelay(ros::NodeHandle& nh, const std::string& inputTopic, uint32_t inputQueueSize, std::string outputTopic, uint32_t outputQueueSize,
+             bool latch = false, unsigned int maxMessageBufferSize = 0,
+             const ros::TransportHints& transport_hints = ros::TransportHints())
+      : nh_(nh),
+        outputTopic_(std::move(outputTopic)),
+        outputQueueSize_(outputQueueSize),
+        latch_(latch),
+        maxMessageBufferSize_(maxMessageBufferSize) {
+    subscriber_ = nh_.subscribe(inputTopic, inputQueueSize, &TopicRelay::relayCallback, this, transport_hints);
+  }
+
+  TopicRelay(const TopicRelay&) = delete;
+  TopicRelay& operator=(const TopicRelay&) = delete;
+
+  virtual ~TopicRelay() { shutdown(); }
+
+  void shutdown() {
+    subscriber_.shutdown();
+    std::lock_guard<std::mutex> publisherLock(publisherMutex_);
+    if (threadedPublisher_) {
+      threadedPublisher_->shutdown();
+    }
+    publisher_.shutdown();
+  }
+
+  /*!
+   * @return True if the first message was received and the output topic is advertised.
+   */
+  bool isAdvertised() const {
+    std::lock_guard<std::mutex> publisherLock(publisherMutex_);
+    return static_cast<bool>(publisher_);
+  }
+
+  uint32_t getNumSubscribers() const {
+    std::lock_guard<std::mutex> publisherLock(publisherMutex_);
+    return publisher_ ? publisher_.getNumSubscribers() : 0;
+  }
+
+ protected:
+  void relayCallback(const boost::shared_ptr<topic_tools::ShapeShifter const>& msg) {
+    std::lock_guard<std::mutex> publisherLock(publisherMutex_);
+    if (!publisher_) {
+      publisher_ = msg->advertise(nh_, outputTopic_, outputQueueSize_, latch_);
+      if (maxMessageBufferSize_ > 0) {
+        threadedPublisher_ = std::make_shared<ThreadedPublisher<topic_tools::ShapeShifter>>(publisher_, maxMessageBufferSize_);
+      }
+      MELO_DEBUG_STREAM("Topic relay: Advertised " << outputTopic_ << " with type " << msg->getDataType() << ".")
+    }
+
+    // The threaded publisher buffers the pointer to the received message, so the serialized message is neither copied nor decoded before
+    // the publisher serializes it for the transport.
+    if (threadedPublisher_) {
+      threadedPublisher_->publish(msg);
+    } else {
+      publisher_.publish(*msg);
+    }
+  }
+
+  ros::NodeHandle nh_;
+  ros::Subscriber subscriber_;
+
+  mutable std::mutex publisherMutex_;
+  ros::Publisher publisher_;
+  ThreadedPublisherPtr<topic_tools::ShapeShifter> threadedPublisher_;
+
+  std::string outputTopic_;
+  uint32_t outputQueueSize_{1};
+  bool latch_{false};
+  unsigned int maxMessageBufferSize_{0};
+};
+
+using TopicRelayPtr = std::shared_ptr<TopicRelay>;
+
+}  // namespace any_node
+
+#endif /* ROS2_BUILD */
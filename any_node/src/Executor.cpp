@@ -0,0 +1,117 @@
+/*!
+ * @file    Executor.cpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#ifdef ROS2_BUILD
+
+#include <pthread.h>
+#include <algorithm>
+#include <cstring>  // strerror(..)
+
+#include <message_logger/message_logger.hpp>
+
+#include "any_node/Executor.hpp"
+#include "any_node/Param.hpp"
+
+namespace any_node {
+
+Executor::Executor(rclcpp::Node::SharedPtr node, const unsigned int numThreads) : node_(std::move(node)) {
+  auto& parameterInterface = *node_->get_node_parameters_interface();
+
+  std::string type = "multi_threaded";
+  getOptionalParameter(parameterInterface, "executor.type", type);
+  if (type != "static_single_threaded" && type != "multi_threaded") {
+    MELO_WARN("Parameter executor.type has invalid value '%s', using multi_threaded.", type.c_str());
+    type = "multi_threaded";
+  }
+  executor_ = createExecutor(type == "static_single_threaded", numThreads);
+  executor_->add_node(node_);
+
+  std::vector<std::string> groupNames;
+  getOptionalParameter(parameterInterface, "executor.callback_group_names", groupNames);
+  for (const auto& name : groupNames) {
+    const std::string prefix = "executor.callback_groups." + name + ".";
+    auto callbackGroup = std::make_unique<CallbackGroup>();
+    callbackGroup->options_.name_ = name;
+    int groupNumThreads = 1;
+    getOptionalParameter(parameterInterface, prefix + "num_threads", groupNumThreads);
+    callbackGroup->options_.numThreads_ = static_cast<unsigned int>(std::max(groupNumThreads, 1));
+    getOptionalParameter(parameterInterface, prefix + "priority", callbackGroup->options_.priority_);
+    getOptionalParameter(parameterInterface, prefix + "cpu", callbackGroup->options_.cpu_);
+    getOptionalParameter(parameterInterface, prefix + "reentrant", callbackGroup->options_.reentrant_);
+
+    // The group is not added to the main executor, but to its own.
+    callbackGroup->group_ = node_->create_callback_group(
+        callbackGroup->options_.reentrant_ ? rclcpp::CallbackGroupType::Reentrant : rclcpp::CallbackGroupType::MutuallyExclusive, false);
+    callbackGroup->executor_ = createExecutor(callbackGroup->options_.numThreads_ == 1, callbackGroup->options_.numThreads_);
+    callbackGroup->executor_->add_callback_group(callbackGroup->group_, node_->get_node_base_interface());
+    callbackGroups_.push_back(std::move(callbackGroup));
+  }
+}
+
+Executor::~Executor() {
+  stop();
+}
+
+void Executor::start() {
+  thread_ = std::thread([this]() { executor_->spin(); });
+
+  for (auto& callbackGroup : callbackGroups_) {
+    callbackGroup->thread_ = std::thread([group = callbackGroup.get()]() {
+      // The scheduling is set before spinning, such that the threads of a multi threaded executor inherit it.
+      const CallbackGroupOptions& options = group->options_;
+      if (options.priority_ != 0) {
+        sched_param sched{};
+        sched.sched_priority = options.priority_;
+        const int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &sched);
+        if (error != 0) {
+          MELO_WARN("Failed to set thread priority for callback group [%s]: %s", options.name_.c_str(), strerror(error));
+        }
+      }
+      if (options.cpu_ >= 0) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(options.cpu_, &cpuSet);
+        const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+        if (error != 0) {
+          MELO_WARN("Failed to set cpu affinity for callback group [%s]: %s", options.name_.c_str(), strerror(error));
+        }
+      }
+      group->executor_->spin();
+    });
+  }
+}
+
+void Executor::stop() {
+  executor_->cancel();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+  for (auto& callbackGroup : callbackGroups_) {
+    callbackGroup->executor_->cancel();
+    if (callbackGroup->thread_.joinable()) {
+      callbackGroup->thread_.join();
+    }
+  }
+}
+
+std::map<std::string, rclcpp::CallbackGroup::SharedPtr> Executor::getCallbackGroups() const {
+  std::map<std::string, rclcpp::CallbackGroup::SharedPtr> callbackGroups;
+  for (const auto& callbackGroup : callbackGroups_) {
+    callbackGroups.emplace(callbackGroup->options_.name_, callbackGroup->group_);
+  }
+  return callbackGroups;
+}
+
+std::shared_ptr<rclcpp::Executor> Executor::createExecutor(const bool singleThreaded, const unsigned int numThreads) {
+  if (singleThreaded) {
+    return std::make_shared<rclcpp::executors::StaticSingleThreadedExecutor>();
+  }
+  return std::make_shared<rclcpp::executors::MultiThreadedExecutor>(rclcpp::ExecutorOptions(), numThreads);
+}
+
+}  // namespace any_node
+
+#endif /* ROS2_BUILD */
@@ -0,0 +1,410 @@
+/*!
+ * @file    MessageLog.cpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <message_logger/message_logger.hpp>
+
+#include "any_node/MessageLog.hpp"
+
+namespace any_node {
+
+namespace {
+
+//! Size of the file header, the magic followed by the committed offset (uint64).
+constexpr uint64_t FileHeaderSize_{16};
+constexpr uint64_t CommittedOffsetPosition_{8};
+
+uint64_t roundUpToPageSize(const uint64_t size) {
+  const auto pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  return (size + pageSize - 1) / pageSize * pageSize;
+}
+
+void appendString(std::vector<uint8_t>& buffer, const std::string& string) {
+  const auto length = static_cast<uint32_t>(string.size());
+  const auto* lengthBytes = reinterpret_cast<const uint8_t*>(&length);
+  buffer.insert(buffer.end(), lengthBytes, lengthBytes + sizeof(length));
+  buffer.insert(buffer.end(), string.begin(), string.end());
+}
+
+bool readString(const uint8_t*& data, const uint8_t* end, std::string& string) {
+  uint32_t length = 0;
+  if (end - data < static_cast<std::ptrdiff_t>(sizeof(length))) {
+    return false;
+  }
+  std::memcpy(&length, data, sizeof(length));
+  data += sizeof(length);
+  if (end - data < static_cast<std::ptrdiff_t>(length)) {
+    return false;
+  }
+  string.assign(reinterpret_cast<const char*>(data), length);
+  data += length;
+  return true;
+}
+
+}  // namespace
+
+MessageLogWriter::~MessageLogWriter() {
+  close();
+}
+
+bool MessageLogWriter::open(const std::string& path, const uint64_t chunkSize) {
+  close();
+  std::lock_guard<std::mutex> lock(mutex_);
+  fileDescriptor_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fileDescriptor_ < 0) {
+    MELO_ERROR("Message log: Failed to create %s: %s", path.c_str(), strerror(errno));
+    return false;
+  }
+  chunkSize_ = roundUpToPageSize(std::max(chunkSize, static_cast<uint64_t>(1)));
+  writeOffset_ = 0;
+  chunkOffset_ = 0;
+  connectionOffsets_.clear();
+  index_.clear();
+  if (!mapChunk(chunkSize_)) {
+    ::close(fileDescriptor_);
+    fileDescriptor_ = -1;
+    return false;
+  }
+  std::memcpy(chunk_, message_log::FileMagic_, sizeof(message_log::FileMagic_));
+  writeOffset_ = FileHeaderSize_;
+  return true;
+}
+
+void MessageLogWriter::close() {
+  std::lock_guard<std::mutex> flushLock(flushMutex_);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (fileDescriptor_ < 0) {
+    return;
+  }
+  unmapChunk();
+
+  // Replace the unused part of the last chunk by the index and the footer.
+  bool success = ftruncate(fileDescriptor_, static_cast<off_t>(writeOffset_)) == 0;
+  message_log::Footer footer;
+  std::memcpy(footer.magic_, message_log::FooterMagic_, sizeof(message_log::FooterMagic_));
+  footer.indexOffset_ = writeOffset_;
+  footer.numIndexEntries_ = index_.size();
+  footer.numConnections_ = connectionOffsets_.size();
+  const auto write = [this, &success](const void* data, const uint64_t size) {
+    success = success && pwrite(fileDescriptor_, data, size, static_cast<off_t>(writeOffset_)) == static_cast<ssize_t>(size);
+    writeOffset_ += size;
+  };
+  write(index_.data(), index_.size() * sizeof(message_log::IndexEntry));
+  write(connectionOffsets_.data(), connectionOffsets_.size() * sizeof(uint64_t));
+  write(&footer, sizeof(footer));
+  success = success && pwrite(fileDescriptor_, &footer.indexOffset_, sizeof(footer.indexOffset_),
+                              static_cast<off_t>(CommittedOffsetPosition_)) == static_cast<ssize_t>(sizeof(footer.indexOffset_));
+  if (!success) {
+    MELO_ERROR("Message log: Failed to write the index: %s", strerror(errno));
+  }
+
+  ::close(fileDescriptor_);
+  fileDescriptor_ = -1;
+}
+
+bool MessageLogWriter::isOpen() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return fileDescriptor_ >= 0;
+}
+
+uint32_t MessageLogWriter::addConnection(const std::string& topic, const std::string& dataType, const std::string& md5Sum,
+                                         const std::string& definition) {
+  std::vector<uint8_t> payload;
+  appendString(payload, topic);
+  appendString(payload, dataType);
+  appendString(payload, md5Sum);
+  appendString(payload, definition);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto connectionId = static_cast<uint32_t>(connectionOffsets_.size());
+  uint8_t* record = reserveRecord(message_log::getRecordSize(payload.size()));
+  if (record == nullptr) {
+    return connectionId;
+  }
+  message_log::RecordHeader header;
+  header.type_ = message_log::RecordType::Connection;
+  header.connectionId_ = connectionId;
+  header.size_ = static_cast<uint32_t>(payload.size());
+  std::memcpy(record + sizeof(header), payload.data(), payload.size());
+  std::memcpy(record, &header, sizeof(header));
+  connectionOffsets_.push_back(chunkOffset_ + (record - chunk_));
+  return connectionId;
+}
+
+bool MessageLogWriter::writeMessage(const uint32_t connectionId, const int64_t stamp, const uint32_t size, const Serializer& serializer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (connectionId >= connectionOffsets_.size()) {
+    return false;
+  }
+  uint8_t* record = reserveRecord(message_log::getRecordSize(size));
+  if (record == nullptr) {
+    return false;
+  }
+  message_log::RecordHeader header;
+  header.type_ = message_log::RecordType::Message;
+  header.connectionId_ = connectionId;
+  header.stamp_ = stamp;
+  header.size_ = size;
+  // The header is written last, such that the record is not recovered while it is incomplete.
+  serializer(record + sizeof(header));
+  std::memcpy(record, &header, sizeof(header));
+  index_.push_back(message_log::IndexEntry{stamp, chunkOffset_ + (record - chunk_)});
+  return true;
+}
+
+bool MessageLogWriter::writeMessage(const uint32_t connectionId, const int64_t stamp, const uint8_t* data, const uint32_t size) {
+  return writeMessage(connectionId, stamp, size, [data, size](uint8_t* buffer) { std::memcpy(buffer, data, size); });
+}
+
+bool MessageLogWriter::flush() {
+  std::lock_guard<std::mutex> flushLock(flushMutex_);
+  uint64_t committedOffset = 0;
+  {
+    // The records before the write offset are complete, the syncing is done without blocking the writers.
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fileDescriptor_ < 0) {
+      return false;
+    }
+    committedOffset = writeOffset_;
+  }
+  // fdatasync also writes back the pages modified through the mappings. The committed offset is only written once the records are on
+  // disk, such that it never points past data which is not.
+  if (fdatasync(fileDescriptor_) != 0 ||
+      pwrite(fileDescriptor_, &committedOffset, sizeof(committedOffset), static_cast<off_t>(CommittedOffsetPosition_)) !=
+          static_cast<ssize_t>(sizeof(committedOffset)) ||
+      fdatasync(fileDescriptor_) != 0) {
+    MELO_ERROR("Message log: Failed to flush: %s", strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+uint64_t MessageLogWriter::getNumMessages() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return index_.size();
+}
+
+uint64_t MessageLogWriter::getSize() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return writeOffset_;
+}
+
+uint8_t* MessageLogWriter::reserveRecord(const uint64_t recordSize) {
+  if (fileDescriptor_ < 0) {
+    return nullptr;
+  }
+
+  // A record has to fill the chunk exactly or leave space for at least a padding record.
+  const uint64_t chunkEnd = chunkOffset_ + mappedSize_;
+  const uint64_t recordEnd = writeOffset_ + recordSize;
+  if (recordEnd != chunkEnd && recordEnd + sizeof(message_log::RecordHeader) > chunkEnd) {
+    const uint64_t remainingSize = chunkEnd - writeOffset_;
+    if (remainingSize > 0) {
+      message_log::RecordHeader padding;
+      padding.type_ = message_log::RecordType::Padding;
+      padding.size_ = static_cast<uint32_t>(remainingSize - sizeof(padding));
+      std::memcpy(chunk_ + (writeOffset_ - chunkOffset_), &padding, sizeof(padding));
+    }
+    unmapChunk();
+    chunkOffset_ = chunkEnd;
+    writeOffset_ = chunkEnd;
+    if (!mapChunk(std::max(chunkSize_, roundUpToPageSize(recordSize + sizeof(message_log::RecordHeader))))) {
+      return nullptr;
+    }
+  }
+
+  uint8_t* record = chunk_ + (writeOffset_ - chunkOffset_);
+  writeOffset_ += recordSize;
+  return record;
+}
+
+bool MessageLogWriter::mapChunk(const uint64_t chunkSize) {
+  if (ftruncate(fileDescriptor_, static_cast<off_t>(chunkOffset_ + chunkSize)) != 0) {
+    MELO_ERROR("Message log: Failed to grow the file: %s", strerror(errno));
+    return false;
+  }
+  void* chunk = mmap(nullptr, chunkSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor_, static_cast<off_t>(chunkOffset_));
+  if (chunk == MAP_FAILED) {
+    MELO_ERROR("Message log: Failed to map the file: %s", strerror(errno));
+    return false;
+  }
+  chunk_ = static_cast<uint8_t*>(chunk);
+  mappedSize_ = chunkSize;
+  return true;
+}
+
+void MessageLogWriter::unmapChunk() {
+  if (chunk_ == nullptr) {
+    return;
+  }
+  // The kernel writes the pages back in the background, munmap does not wait for it.
+  msync(chunk_, mappedSize_, MS_ASYNC);
+  munmap(chunk_, mappedSize_);
+  chunk_ = nullptr;
+  mappedSize_ = 0;
+}
+
+MessageLogReader::~MessageLogReader() {
+  close();
+}
+
+bool MessageLogReader::open(const std::string& path) {
+  close();
+  const int fileDescriptor = ::open(path.c_str(), O_RDONLY);
+  if (fileDescriptor < 0) {
+    MELO_ERROR("Message log: Failed to open %s: %s", path.c_str(), strerror(errno));
+    return false;
+  }
+  struct stat fileStatus {};
+  if (fstat(fileDescriptor, &fileStatus) != 0 || static_cast<uint64_t>(fileStatus.st_size) < FileHeaderSize_) {
+    MELO_ERROR("Message log: %s is not a message log.", path.c_str());
+    ::close(fileDescriptor);
+    return false;
+  }
+  size_ = static_cast<uint64_t>(fileStatus.st_size);
+  void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+  ::close(fileDescriptor);
+  if (data == MAP_FAILED) {
+    MELO_ERROR("Message log: Failed to map %s: %s", path.c_str(), strerror(errno));
+    size_ = 0;
+    return false;
+  }
+  data_ = static_cast<uint8_t*>(data);
+  if (std::memcmp(data_, message_log::FileMagic_, sizeof(message_log::FileMagic_)) != 0) {
+    MELO_ERROR("Message log: %s is not a message log.", path.c_str());
+    close();
+    return false;
+  }
+
+  message_log::Footer footer;
+  if (size_ >= FileHeaderSize_ + sizeof(footer)) {
+    std::memcpy(&footer, data_ + size_ - sizeof(footer), sizeof(footer));
+  }
+  const uint64_t indexSize = footer.numIndexEntries_ * sizeof(message_log::IndexEntry) + footer.numConnections_ * sizeof(uint64_t);
+  if (std::memcmp(footer.magic_, message_log::FooterMagic_, sizeof(message_log::FooterMagic_)) == 0 &&
+      footer.indexOffset_ + indexSize + sizeof(footer) == size_) {
+    recordsEnd_ = footer.indexOffset_;
+    index_.resize(footer.numIndexEntries_);
+    std::memcpy(index_.data(), data_ + footer.indexOffset_, footer.numIndexEntries_ * sizeof(message_log::IndexEntry));
+    std::vector<uint64_t> connectionOffsets(footer.numConnections_);
+    std::memcpy(connectionOffsets.data(), data_ + footer.indexOffset_ + footer.numIndexEntries_ * sizeof(message_log::IndexEntry),
+                footer.numConnections_ * sizeof(uint64_t));
+    for (const auto offset : connectionOffsets) {
+      if (!readConnection(offset)) {
+        MELO_ERROR("Message log: %s has an invalid connection record.", path.c_str());
+        close();
+        return false;
+      }
+    }
+  } else {
+    uint64_t committedOffset = 0;
+    std::memcpy(&committedOffset, data_ + CommittedOffsetPosition_, sizeof(committedOffset));
+    MELO_WARN("Message log: %s was not closed properly, rebuilding the index from the first %lu bytes.", path.c_str(), committedOffset);
+    recordsEnd_ = std::min(committedOffset, size_);
+    scanRecords(recordsEnd_);
+  }
+
+  // Messages of different publishers are not necessarily written in the order of their stamps.
+  std::stable_sort(index_.begin(), index_.end(),
+                   [](const message_log::IndexEntry& lhs, const message_log::IndexEntry& rhs) { return lhs.stamp_ < rhs.stamp_; });
+  return true;
+}
+
+void MessageLogReader::close() {
+  if (data_ != nullptr) {
+    munmap(data_, size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  recordsEnd_ = 0;
+  connections_.clear();
+  index_.clear();
+}
+
+MessageLogReader::Message MessageLogReader::getMessage(const uint64_t index) const {
+  Message message;
+  if (index >= index_.size()) {
+    return message;
+  }
+  const uint64_t offset = index_[index].offset_;
+  message_log::RecordHeader header;
+  if (offset < FileHeaderSize_ || offset > recordsEnd_ || recordsEnd_ - offset < sizeof(header)) {
+    MELO_ERROR("Message log: Message %lu has an invalid offset %lu.", index, offset);
+    return message;
+  }
+  std::memcpy(&header, data_ + offset, sizeof(header));
+  if (header.type_ != message_log::RecordType::Message || header.size_ > recordsEnd_ - offset - sizeof(header)) {
+    MELO_ERROR("Message log: Message %lu has a corrupt record header.", index);
+    return message;
+  }
+  if (header.connectionId_ < connections_.size()) {
+    message.connection_ = &connections_[header.connectionId_];
+  }
+  message.stamp_ = header.stamp_;
+  message.data_ = data_ + offset + sizeof(header);
+  message.size_ = header.size_;
+  return message;
+}
+
+uint64_t MessageLogReader::seek(const int64_t stamp) const {
+  const auto it = std::lower_bound(index_.begin(), index_.end(), stamp,
+                                   [](const message_log::IndexEntry& entry, const int64_t value) { return entry.stamp_ < value; });
+  return static_cast<uint64_t>(it - index_.begin());
+}
+
+bool MessageLogReader::readConnection(const uint64_t offset) {
+  message_log::RecordHeader header;
+  if (offset + sizeof(header) > size_) {
+    return false;
+  }
+  std::memcpy(&header, data_ + offset, sizeof(header));
+  if (header.type_ != message_log::RecordType::Connection || offset + sizeof(header) + header.size_ > size_) {
+    return false;
+  }
+  const uint8_t* payload = data_ + offset + sizeof(header);
+  const uint8_t* payloadEnd = payload + header.size_;
+  message_log::Connection connection;
+  connection.id_ = header.connectionId_;
+  if (!readString(payload, payloadEnd, connection.topic_) || !readString(payload, payloadEnd, connection.dataType_) ||
+      !readString(payload, payloadEnd, connection.md5Sum_) || !readString(payload, payloadEnd, connection.definition_)) {
+    return false;
+  }
+  if (connection.id_ != connections_.size()) {
+    return false;
+  }
+  connections_.push_back(std::move(connection));
+  return true;
+}
+
+void MessageLogReader::scanRecords(const uint64_t endOffset) {
+  uint64_t offset = FileHeaderSize_;
+  while (offset + sizeof(message_log::RecordHeader) <= endOffset) {
+    message_log::RecordHeader header;
+    std::memcpy(&header, data_ + offset, sizeof(header));
+    const uint64_t recordSize = message_log::getRecordSize(header.size_);
+    if (header.type_ == message_log::RecordType::End || offset + recordSize > endOffset) {
+      // Unused part of the last chunk or a record which was not committed.
+      break;
+    }
+    if (header.type_ == message_log::RecordType::Connection) {
+      if (!readConnection(offset)) {
+        break;
+      }
+    } else if (header.type_ == message_log::RecordType::Message) {
+      index_.push_back(message_log::IndexEntry{header.stamp_, offset});
+    }
+    offset += recordSize;
+  }
+}
+
+}  // namespace any_node
@@ -4,22 +4,197 @@
  * @date	July, 2016
  */
 
+#include <algorithm>
+#include <cctype>
 #include <csignal>
+#include <iterator>
 
 #include <message_logger/message_logger.hpp>
 
 #include "any_node/Node.hpp"
+#include "any_node/RealtimeProfile.hpp"
 
 namespace any_node {
 
+namespace {
+
+const std::string HeartbeatWorkerName_{"heartbeat"};
+
+std::string getWorkerParameterName(std::string name) {
+  for (auto& c : name) {
+    if (std::isalnum(static_cast<unsigned char>(c)) == 0 && c != '_') {
+      c = '_';
+    }
+  }
+  return name;
+}
+
+bool parseSchedPolicy(const std::string& name, int& policy) {
+  static const std::map<std::string, int> policies{
+      {"fifo", SCHED_FIFO}, {"rr", SCHED_RR}, {"other", SCHED_OTHER}, {"batch", SCHED_BATCH}, {"idle", SCHED_IDLE}};
+  const auto it = policies.find(name);
+  if (it == policies.end()) {
+    return false;
+  }
+  policy = it->second;
+  return true;
+}
+
+}  // namespace
+
 Node::Node(NodeHandlePtr nh) : nh_(std::move(nh)), workerManager_() {}
 
+any_worker::WorkerOptions Node::loadWorkerOptions(any_worker::WorkerOptions options) const {
+  const std::string name = getWorkerParameterName(options.name_);
+  double timeStep = options.timeStep_;
+  std::string policy;
+  std::string cpuSet;
+#ifndef ROS2_BUILD
+  if (!nh_->hasParam("workers/" + name)) {
+    return options;
+  }
+  const std::string prefix = "workers/" + name + "/";
+  nh_->getParam(prefix + "time_step", timeStep);
+  nh_->getParam(prefix + "priority", options.defaultPriority_);
+  nh_->getParam(prefix + "affinity", options.schedAffinity_);
+  nh_->getParam(prefix + "policy", policy);
+  nh_->getParam(prefix + "cpu_set", cpuSet);
+#else  /* ROS2_BUILD */
+  const std::string prefix = "workers." + name + ".";
+  auto& parameterInterface = *nh_->get_node_parameters_interface();
+  getOptionalParameter(parameterInterface, prefix + "time_step", timeStep);
+  getOptionalParameter(parameterInterface, prefix + "priority", options.defaultPriority_);
+  getOptionalParameter(parameterInterface, prefix + "affinity", options.schedAffinity_);
+  getOptionalParameter(parameterInterface, prefix + "policy", policy);
+  getOptionalParameter(parameterInterface, prefix + "cpu_set", cpuSet);
+#endif /* ROS2_BUILD */
+  options.timeStep_ = timeStep;
+  if (!policy.empty() && !parseSchedPolicy(policy, options.schedPolicy_)) {
+    MELO_WARN("Worker [%s]: Unknown scheduling policy '%s', expected fifo, rr, other, batch or idle.", options.name_.c_str(),
+              policy.c_str());
+  }
+  if (!cpuSet.empty() && !RealtimeProfile::parseCpuList(cpuSet, options.schedCpuSet_)) {
+    MELO_WARN("Worker [%s]: Invalid CPU set '%s'.", options.name_.c_str(), cpuSet.c_str());
+    options.schedCpuSet_.clear();
+  }
+  return options;
+}
+
+bool Node::startHeartbeat() {
+  double timeStep = 0.0;
+#ifndef ROS2_BUILD
+  timeStep = param<double>("heartbeat/time_step", 0.0);
+#else  /* ROS2_BUILD */
+  getOptionalParameter(*nh_->get_node_parameters_interface(), "heartbeat.time_step", timeStep);
+#endif /* ROS2_BUILD */
+  if (timeStep <= 0.0) {
+    return true;
+  }
+
+#ifndef ROS2_BUILD
+  heartbeatPublisher_ = advertise<std_msgs::UInt64>("heartbeat", "heartbeat", 1);
+#else  /* ROS2_BUILD */
+  heartbeatPublisher_ = advertise<std_msgs::msg::UInt64>("heartbeat", "heartbeat", 1);
+#endif /* ROS2_BUILD */
+  // Lowest priority, a heartbeat delayed by the other workers indicates an overloaded node.
+  return workerManager_.addWorker(HeartbeatWorkerName_, timeStep, &Node::publishHeartbeat, this, 0);
+}
+
+bool Node::publishHeartbeat(const any_worker::WorkerEvent& /*event*/) {
+  const auto numRateErrors = workerManager_.getNumRateErrors();
+  for (auto it = heartbeatNumRateErrors_.begin(); it != heartbeatNumRateErrors_.end();) {
+    it = numRateErrors.count(it->first) == 0 ? heartbeatNumRateErrors_.erase(it) : std::next(it);
+  }
+
+  uint32_t healthFlags = 0;
+  for (const auto& worker : numRateErrors) {
+    if (worker.first == HeartbeatWorkerName_) {
+      continue;
+    }
+    auto& previousNumRateErrors = heartbeatNumRateErrors_[worker.first];
+    const int bit = getHeartbeatBit(worker.first);
+    if (bit >= 0 && worker.second > previousNumRateErrors) {
+      healthFlags |= 1u << static_cast<unsigned int>(bit);
+    }
+    previousNumRateErrors = worker.second;
+  }
+
+#ifndef ROS2_BUILD
+  std_msgs::UInt64 heartbeat;
+  heartbeat.data = heartbeat::encode(heartbeatSequence_++, healthFlags);
+  heartbeatPublisher_.publish(heartbeat);
+#else  /* ROS2_BUILD */
+  std_msgs::msg::UInt64 heartbeat;
+  heartbeat.data = heartbeat::encode(heartbeatSequence_++, healthFlags);
+  heartbeatPublisher_->publish(heartbeat);
+#endif /* ROS2_BUILD */
+  return true;
+}
+
+int Node::getHeartbeatBit(const std::string& workerName) {
+  const auto assignedBit = heartbeatBits_.find(workerName);
+  if (assignedBit != heartbeatBits_.end()) {
+    return assignedBit->second;
+  }
+
+  int bit = -1;
+#ifndef ROS2_BUILD
+  const std::string parameter = "heartbeat/worker_bits/" + getWorkerParameterName(workerName);
+  nh_->getParam(parameter, bit);
+#else  /* ROS2_BUILD */
+  const std::string parameter = "heartbeat.worker_bits." + getWorkerParameterName(workerName);
+  auto& parameterInterface = *nh_->get_node_parameters_interface();
+  getOptionalParameter(parameterInterface, parameter, bit);
+#endif /* ROS2_BUILD */
+  const auto isUsed = [this](const int usedBit) {
+    return std::any_of(heartbeatBits_.begin(), heartbeatBits_.end(), [usedBit](const auto& entry) { return entry.second == usedBit; });
+  };
+  if (bit >= 32 || (bit >= 0 && isUsed(bit))) {
+    MELO_WARN("Heartbeat: Health bit %d of worker [%s] is invalid or already used, assigning a free one.", bit, workerName.c_str());
+    bit = -1;
+  }
+  for (int freeBit = 0; bit < 0 && freeBit < 32; freeBit++) {
+    if (!isUsed(freeBit)) {
+      bit = freeBit;
+    }
+  }
+  heartbeatBits_.emplace(workerName, bit);
+  if (bit < 0) {
+    MELO_WARN("Heartbeat: All 32 health bits are used, the health of worker [%s] is not reported.", workerName.c_str());
+    return bit;
+  }
+
+  // Publish the assignment, such that peers can look up which worker a bit refers to.
+#ifndef ROS2_BUILD
+  nh_->setParam(parameter, bit);
+#else  /* ROS2_BUILD */
+  if (parameterInterface.has_parameter(parameter)) {
+    nh_->set_parameter(rclcpp::Parameter(parameter, bit));
+  } else {
+    nh_->declare_parameter(parameter, bit);
+  }
+#endif /* ROS2_BUILD */
+  MELO_INFO("Heartbeat: Health bit %d reports worker [%s].", bit, workerName.c_str());
+  return bit;
+}
+
 void Node::shutdown() {
   // raise SIGINT, which will be caught by the owner of the node instance and initiates the shutdown
   // todo: is there a better way?
   raise(SIGINT);
 }
 
+#ifdef ROS2_BUILD
+rclcpp::CallbackGroup::SharedPtr Node::getCallbackGroup(const std::string& name) const {
+  const auto callbackGroup = callbackGroups_.find(name);
+  if (callbackGroup == callbackGroups_.end()) {
+    MELO_WARN("Callback group %s does not exist, using the default callback group.", name.c_str());
+    return nullptr;
+  }
+  return callbackGroup->second;
+}
+#endif /* ROS2_BUILD */
+
 bool setProcessPriority(int priority) {
   sched_param params{};
   params.sched_priority = priority;
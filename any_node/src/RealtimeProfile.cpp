@@ -0,0 +1,207 @@
+/*!
+ * @file    RealtimeProfile.cpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <message_logger/message_logger.hpp>
+
+#include "any_node/RealtimeProfile.hpp"
+
+namespace any_node {
+
+RealtimeProfile::RealtimeProfile(RealtimeProfileOptions options, std::string rootPath)
+    : options_(std::move(options)), rootPath_(std::move(rootPath)) {}
+
+RealtimeProfile::~RealtimeProfile() {
+  release();
+}
+
+bool RealtimeProfile::acquire() {
+  if (options_.cpuDmaLatency_ < 0 || isAcquired()) {
+    return true;
+  }
+  const std::string path = rootPath_ + "/dev/cpu_dma_latency";
+  cpuDmaLatencyFileDescriptor_ = open(path.c_str(), O_WRONLY);
+  if (cpuDmaLatencyFileDescriptor_ < 0) {
+    MELO_WARN("Real-time profile: Failed to open %s: %s. Check the permissions of the file.", path.c_str(), strerror(errno));
+    return false;
+  }
+  // The request is held as long as the file is open.
+  const auto latency = static_cast<int32_t>(options_.cpuDmaLatency_);
+  if (write(cpuDmaLatencyFileDescriptor_, &latency, sizeof(latency)) != static_cast<ssize_t>(sizeof(latency))) {
+    MELO_WARN("Real-time profile: Failed to request a CPU latency of %d us: %s", options_.cpuDmaLatency_, strerror(errno));
+    release();
+    return false;
+  }
+  MELO_INFO("Real-time profile: Requested a CPU latency of %d us.", options_.cpuDmaLatency_);
+  return true;
+}
+
+void RealtimeProfile::release() {
+  if (cpuDmaLatencyFileDescriptor_ < 0) {
+    return;
+  }
+  close(cpuDmaLatencyFileDescriptor_);
+  cpuDmaLatencyFileDescriptor_ = -1;
+}
+
+bool RealtimeProfile::check() const {
+  std::vector<int> isolatedCpus;
+  if (!parseCpuList(options_.isolatedCpus_, isolatedCpus)) {
+    MELO_WARN("Real-time profile: Invalid list of isolated CPUs '%s'.", options_.isolatedCpus_.c_str());
+    return false;
+  }
+  bool success = true;
+  success = checkGovernor(isolatedCpus) && success;
+  success = checkIsolation(isolatedCpus) && success;
+  success = checkIrqAffinity(isolatedCpus) && success;
+  return success;
+}
+
+bool RealtimeProfile::parseCpuList(const std::string& cpuList, std::vector<int>& cpus) {
+  cpus.clear();
+  std::stringstream stream(cpuList);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    range.erase(std::remove_if(range.begin(), range.end(), [](const char c) { return std::isspace(c) != 0; }), range.end());
+    if (range.empty()) {
+      continue;
+    }
+    int first = 0;
+    int last = 0;
+    char separator = '\0';
+    std::stringstream rangeStream(range);
+    rangeStream >> first;
+    if (rangeStream.fail() || first < 0) {
+      return false;
+    }
+    last = first;
+    if (rangeStream >> separator) {
+      if (separator != '-' || !(rangeStream >> last) || last < first || !rangeStream.eof()) {
+        return false;
+      }
+    }
+    for (int cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return true;
+}
+
+bool RealtimeProfile::checkGovernor(const std::vector<int>& isolatedCpus) const {
+  if (options_.governor_.empty()) {
+    return true;
+  }
+  std::vector<int> cpus = isolatedCpus;
+  std::string onlineCpus;
+  if (cpus.empty() && (!readFile(rootPath_ + "/sys/devices/system/cpu/online", onlineCpus) || !parseCpuList(onlineCpus, cpus))) {
+    MELO_WARN("Real-time profile: Failed to read the online CPUs.");
+    return false;
+  }
+
+  bool success = true;
+  for (const int cpu : cpus) {
+    std::string governor;
+    if (!readFile(rootPath_ + "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cpufreq/scaling_governor", governor)) {
+      // No frequency scaling, e.g. in virtual machines.
+      MELO_DEBUG("Real-time profile: CPU %d has no frequency governor.", cpu);
+      continue;
+    }
+    if (governor != options_.governor_) {
+      MELO_WARN("Real-time profile: CPU %d uses the frequency governor '%s' instead of '%s'.", cpu, governor.c_str(),
+                options_.governor_.c_str());
+      success = false;
+    }
+  }
+  return success;
+}
+
+bool RealtimeProfile::checkIsolation(const std::vector<int>& isolatedCpus) const {
+  if (isolatedCpus.empty()) {
+    return true;
+  }
+  std::string isolated;
+  std::vector<int> actualIsolatedCpus;
+  if (!readFile(rootPath_ + "/sys/devices/system/cpu/isolated", isolated) || !parseCpuList(isolated, actualIsolatedCpus)) {
+    MELO_WARN("Real-time profile: Failed to read the isolated CPUs.");
+    return false;
+  }
+
+  bool success = true;
+  for (const int cpu : isolatedCpus) {
+    if (!std::binary_search(actualIsolatedCpus.begin(), actualIsolatedCpus.end(), cpu)) {
+      MELO_WARN("Real-time profile: CPU %d is not isolated (isolated CPUs: '%s'), add it to the isolcpus kernel parameter.", cpu,
+                isolated.c_str());
+      success = false;
+    }
+  }
+  return success;
+}
+
+bool RealtimeProfile::checkIrqAffinity(const std::vector<int>& isolatedCpus) const {
+  if (!options_.checkIrqAffinity_ || isolatedCpus.empty()) {
+    return true;
+  }
+  const std::string irqPath = rootPath_ + "/proc/irq";
+  DIR* directory = opendir(irqPath.c_str());
+  if (directory == nullptr) {
+    MELO_WARN("Real-time profile: Failed to open %s: %s", irqPath.c_str(), strerror(errno));
+    return false;
+  }
+
+  std::vector<std::string> irqs;
+  while (const dirent* entry = readdir(directory)) {
+    const std::string irq = entry->d_name;
+    std::string affinity;
+    std::vector<int> cpus;
+    if (irq.empty() || !std::all_of(irq.begin(), irq.end(), [](const char c) { return std::isdigit(c) != 0; }) ||
+        !readFile(irqPath + "/" + irq + "/smp_affinity_list", affinity) || !parseCpuList(affinity, cpus)) {
+      continue;
+    }
+    for (const int cpu : isolatedCpus) {
+      if (std::binary_search(cpus.begin(), cpus.end(), cpu)) {
+        irqs.push_back(irq);
+        break;
+      }
+    }
+  }
+  closedir(directory);
+
+  if (irqs.empty()) {
+    return true;
+  }
+  std::sort(irqs.begin(), irqs.end(), [](const std::string& lhs, const std::string& rhs) { return std::stoi(lhs) < std::stoi(rhs); });
+  std::string irqList;
+  for (const auto& irq : irqs) {
+    irqList += (irqList.empty() ? "" : ", ") + irq;
+  }
+  MELO_WARN("Real-time profile: The interrupts %s can be handled by the isolated CPUs, set their smp_affinity (e.g. with irqbalance).",
+            irqList.c_str());
+  return false;
+}
+
+bool RealtimeProfile::readFile(const std::string& path, std::string& content) const {
+  std::ifstream file(path);
+  if (!file.is_open() || !std::getline(file, content)) {
+    return false;
+  }
+  // Strip the trailing newline and whitespace written by the kernel.
+  content.erase(std::find_if(content.rbegin(), content.rend(), [](const char c) { return std::isspace(c) == 0; }).base(), content.end());
+  return true;
+}
+
+}  // namespace any_node
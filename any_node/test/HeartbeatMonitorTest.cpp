@@ -0,0 +1,58 @@
+// std
+#include <string>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// any node
+#include "any_node/Heartbeat.hpp"
+
+TEST(Heartbeat, Encoding) {  // NOLINT
+  const uint64_t heartbeat = any_node::heartbeat::encode(42, 0x80000001u);
+  EXPECT_EQ(any_node::heartbeat::getSequence(heartbeat), 42u);
+  EXPECT_EQ(any_node::heartbeat::getHealthFlags(heartbeat), 0x80000001u);
+}
+
+TEST(HeartbeatMonitor, Liveness) {  // NOLINT
+  std::vector<std::pair<std::string, bool>> changes;
+  any_node::HeartbeatMonitor monitor(1.0, [&changes](const std::string& peer, const any_node::HeartbeatMonitor::PeerStatus& status) {
+    changes.emplace_back(peer, status.alive_);
+  });
+  monitor.addPeer("a");
+  EXPECT_FALSE(monitor.isAlive("a"));
+  EXPECT_FALSE(monitor.areAllHealthy());
+
+  const int64_t second = 1000000000;
+  monitor.receive("a", any_node::heartbeat::encode(0, 0), 0);
+  monitor.receive("a", any_node::heartbeat::encode(1, 0), second / 2);
+  EXPECT_TRUE(monitor.isAlive("a"));
+  EXPECT_TRUE(monitor.areAllHealthy());
+  monitor.check(second);
+  EXPECT_TRUE(monitor.isAlive("a"));
+  ASSERT_EQ(changes.size(), 1u);
+  EXPECT_TRUE(changes[0].second);
+
+  // Two heartbeats missed and a worker reported unhealthy.
+  monitor.receive("a", any_node::heartbeat::encode(4, 0x2), second);
+  EXPECT_FALSE(monitor.areAllHealthy());
+  any_node::HeartbeatMonitor::PeerStatus status;
+  ASSERT_TRUE(monitor.getStatus("a", status));
+  EXPECT_EQ(status.numMissed_, 2u);
+  EXPECT_EQ(status.numReceived_, 3u);
+  EXPECT_EQ(status.healthFlags_, 0x2u);
+
+  // Timeout.
+  monitor.check(2 * second + 1);
+  EXPECT_FALSE(monitor.isAlive("a"));
+  ASSERT_EQ(changes.size(), 2u);
+  EXPECT_EQ(changes[1].first, "a");
+  EXPECT_FALSE(changes[1].second);
+
+  // A restart resets the sequence number, which is not counted as missed heartbeats.
+  monitor.receive("a", any_node::heartbeat::encode(0, 0), 3 * second);
+  EXPECT_TRUE(monitor.isAlive("a"));
+  ASSERT_TRUE(monitor.getStatus("a", status));
+  EXPECT_EQ(status.numMissed_, 2u);
+  EXPECT_FALSE(monitor.getStatus("b", status));
+}
@@ -0,0 +1,64 @@
+// std
+#include <chrono>
+#include <cmath>
+
+// gtest
+#include <gtest/gtest.h>
+
+// any node
+#include "any_node/LatencyTracer.hpp"
+
+TEST(LatencyHistogram, Percentiles) {  // NOLINT
+  any_node::LatencyHistogram histogram;
+  EXPECT_TRUE(std::isnan(histogram.getPercentile(50.0)));
+
+  // 90 samples at 1 ms, 10 samples at 100 ms.
+  for (unsigned int i = 0; i < 90; i++) {
+    histogram.add(0.001);
+  }
+  for (unsigned int i = 0; i < 10; i++) {
+    histogram.add(0.1);
+  }
+
+  EXPECT_EQ(histogram.getNumSamples(), 100u);
+  EXPECT_NEAR(histogram.getPercentile(50.0), 0.001, 1e-9);
+  EXPECT_NEAR(histogram.getPercentile(90.0), 0.001, 1e-9);
+  EXPECT_NEAR(histogram.getPercentile(99.0), 0.1, 1e-9);
+  EXPECT_DOUBLE_EQ(histogram.getPercentile(100.0), 0.1);
+  EXPECT_DOUBLE_EQ(histogram.getStatistics().getMax(), 0.1);
+}
+
+TEST(LatencyHistogram, UnderAndOverflow) {  // NOLINT
+  any_node::LatencyHistogram histogram;
+  histogram.add(-0.001);
+  histogram.add(1000.0);
+
+  EXPECT_EQ(histogram.getCounts().front(), 1u);
+  EXPECT_EQ(histogram.getCounts().back(), 1u);
+  EXPECT_DOUBLE_EQ(histogram.getPercentile(100.0), 1000.0);
+}
+
+TEST(LatencyTracer, NodeLatency) {  // NOLINT
+  any_node::LatencyTracer tracer("test");
+  const auto time = any_node::LatencyTracer::Clock::now();
+  const int64_t stamp = 1000000000;
+
+  // Input received 2 ms after the measurement, output published 3 ms later.
+  tracer.addInput(stamp, stamp + 2000000, time);
+  tracer.addInput(stamp + 10000000, stamp + 12000000, time + std::chrono::milliseconds(10));
+  tracer.addOutput(stamp, stamp + 5000000, time + std::chrono::milliseconds(3));
+
+  // An output without matching input only counts for the chain latency.
+  tracer.addOutput(stamp + 1, stamp + 5000000, time + std::chrono::milliseconds(3));
+
+  EXPECT_EQ(tracer.getInputLatency().getNumSamples(), 2u);
+  EXPECT_DOUBLE_EQ(tracer.getInputLatency().getStatistics().getMean(), 0.002);
+  EXPECT_EQ(tracer.getOutputLatency().getNumSamples(), 2u);
+  EXPECT_NEAR(tracer.getOutputLatency().getStatistics().getMax(), 0.005, 1e-9);
+  EXPECT_EQ(tracer.getNodeLatency().getNumSamples(), 1u);
+  EXPECT_NEAR(tracer.getNodeLatency().getStatistics().getMean(), 0.003, 1e-9);
+  EXPECT_FALSE(tracer.getReport().empty());
+
+  tracer.reset();
+  EXPECT_EQ(tracer.getNodeLatency().getNumSamples(), 0u);
+}
@@ -0,0 +1,208 @@
+// std
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// any node
+#include "any_node/MessageLog.hpp"
+
+namespace {
+
+std::string getTestFilePath(const std::string& name) {
+  return testing::TempDir() + "message_log_test_" + name + ".log";
+}
+
+std::vector<uint8_t> makePayload(const uint32_t size, const uint8_t value) {
+  return std::vector<uint8_t>(size, value);
+}
+
+}  // namespace
+
+TEST(MessageLog, WriteAndRead) {  // NOLINT
+  const std::string path = getTestFilePath("write_and_read");
+  {
+    any_node::MessageLogWriter writer;
+    // Small chunks to exercise the chunk switching.
+    ASSERT_TRUE(writer.open(path, 4096));
+    const uint32_t connectionA = writer.addConnection("/a", "std_msgs/String", "md5a", "string data");
+    const uint32_t connectionB = writer.addConnection("/b", "std_msgs/Empty", "md5b", "");
+
+    for (unsigned int i = 0; i < 100; i++) {
+      const auto payload = makePayload(100 + i, static_cast<uint8_t>(i));
+      EXPECT_TRUE(writer.writeMessage(i % 2 == 0 ? connectionA : connectionB, 1000 * i, payload.data(), payload.size()));
+    }
+    // Message larger than a chunk.
+    const auto largePayload = makePayload(10000, 42);
+    EXPECT_TRUE(writer.writeMessage(connectionA, 1000 * 100, largePayload.size(),
+                                    [&largePayload](uint8_t* buffer) { std::memcpy(buffer, largePayload.data(), largePayload.size()); }));
+    // Message with an earlier stamp, the reader orders the messages by stamp.
+    const auto latePayload = makePayload(1, 7);
+    EXPECT_TRUE(writer.writeMessage(connectionB, 500, latePayload.data(), latePayload.size()));
+    // Unknown connection.
+    EXPECT_FALSE(writer.writeMessage(5, 0, latePayload.data(), latePayload.size()));
+    EXPECT_EQ(writer.getNumMessages(), 102u);
+  }
+
+  any_node::MessageLogReader reader;
+  ASSERT_TRUE(reader.open(path));
+  ASSERT_EQ(reader.getConnections().size(), 2u);
+  EXPECT_EQ(reader.getConnections()[0].topic_, "/a");
+  EXPECT_EQ(reader.getConnections()[0].definition_, "string data");
+  EXPECT_EQ(reader.getConnections()[1].dataType_, "std_msgs/Empty");
+  ASSERT_EQ(reader.getNumMessages(), 102u);
+
+  const auto first = reader.getMessage(0);
+  EXPECT_EQ(first.stamp_, 0);
+  EXPECT_EQ(first.connection_->topic_, "/a");
+  EXPECT_EQ(first.size_, 100u);
+  const auto late = reader.getMessage(1);
+  EXPECT_EQ(late.stamp_, 500);
+  EXPECT_EQ(late.connection_->topic_, "/b");
+  EXPECT_EQ(late.data_[0], 7);
+  for (unsigned int i = 1; i < 100; i++) {
+    const auto message = reader.getMessage(i + 1);
+    EXPECT_EQ(message.stamp_, 1000 * i);
+    ASSERT_EQ(message.size_, 100 + i);
+    EXPECT_EQ(message.data_[0], static_cast<uint8_t>(i));
+    EXPECT_EQ(message.data_[message.size_ - 1], static_cast<uint8_t>(i));
+  }
+  const auto large = reader.getMessage(101);
+  EXPECT_EQ(large.size_, 10000u);
+  EXPECT_EQ(large.data_[9999], 42);
+
+  reader.close();
+  std::remove(path.c_str());
+}
+
+TEST(MessageLog, RebuildIndex) {  // NOLINT
+  const std::string path = getTestFilePath("rebuild_index");
+  any_node::MessageLogWriter writer;
+  ASSERT_TRUE(writer.open(path, 4096));
+  const uint32_t connection = writer.addConnection("/a", "std_msgs/String", "", "");
+  for (unsigned int i = 0; i < 50; i++) {
+    const auto payload = makePayload(200, static_cast<uint8_t>(i));
+    writer.writeMessage(connection, i, payload.data(), payload.size());
+  }
+  writer.flush();
+
+  // The writer is not closed yet, so the file has no index.
+  any_node::MessageLogReader reader;
+  ASSERT_TRUE(reader.open(path));
+  ASSERT_EQ(reader.getConnections().size(), 1u);
+  ASSERT_EQ(reader.getNumMessages(), 50u);
+  EXPECT_EQ(reader.getMessage(49).stamp_, 49);
+  EXPECT_EQ(reader.getMessage(49).data_[0], 49);
+
+  reader.close();
+  writer.close();
+  std::remove(path.c_str());
+}
+
+TEST(MessageLog, RecoverCommittedRecordsOnly) {  // NOLINT
+  const std::string path = getTestFilePath("recover_committed_records_only");
+  any_node::MessageLogWriter writer;
+  ASSERT_TRUE(writer.open(path, 4096));
+  const uint32_t connection = writer.addConnection("/a", "std_msgs/String", "", "");
+  const auto payload = makePayload(200, 1);
+  for (unsigned int i = 0; i < 10; i++) {
+    writer.writeMessage(connection, i, payload.data(), payload.size());
+  }
+
+  // Nothing is committed before the first flush.
+  any_node::MessageLogReader reader;
+  ASSERT_TRUE(reader.open(path));
+  EXPECT_EQ(reader.getConnections().size(), 0u);
+  EXPECT_EQ(reader.getNumMessages(), 0u);
+  reader.close();
+
+  EXPECT_TRUE(writer.flush());
+  // Written after the flush, hence not recovered.
+  for (unsigned int i = 10; i < 20; i++) {
+    writer.writeMessage(connection, i, payload.data(), payload.size());
+  }
+  ASSERT_TRUE(reader.open(path));
+  EXPECT_EQ(reader.getConnections().size(), 1u);
+  ASSERT_EQ(reader.getNumMessages(), 10u);
+  EXPECT_EQ(reader.getMessage(9).stamp_, 9);
+  reader.close();
+
+  // Closing commits all records.
+  writer.close();
+  ASSERT_TRUE(reader.open(path));
+  EXPECT_EQ(reader.getNumMessages(), 20u);
+  reader.close();
+  std::remove(path.c_str());
+}
+
+TEST(MessageLog, Seek) {  // NOLINT
+  const std::string path = getTestFilePath("seek");
+  {
+    any_node::MessageLogWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    const uint32_t connection = writer.addConnection("/a", "std_msgs/UInt8", "", "");
+    for (unsigned int i = 0; i < 10; i++) {
+      const auto payload = makePayload(1, static_cast<uint8_t>(i));
+      writer.writeMessage(connection, 10 * i, payload.data(), payload.size());
+    }
+  }
+
+  any_node::MessageLogReader reader;
+  ASSERT_TRUE(reader.open(path));
+  EXPECT_EQ(reader.seek(-5), 0u);
+  EXPECT_EQ(reader.seek(0), 0u);
+  EXPECT_EQ(reader.seek(35), 4u);
+  EXPECT_EQ(reader.seek(40), 4u);
+  EXPECT_EQ(reader.seek(90), 9u);
+  EXPECT_EQ(reader.seek(91), 10u);
+
+  reader.close();
+  std::remove(path.c_str());
+}
+
+TEST(MessageLog, CorruptRecord) {  // NOLINT
+  const std::string path = getTestFilePath("corrupt_record");
+  const int64_t stamp = 0x1122334455667788;
+  {
+    any_node::MessageLogWriter writer;
+    ASSERT_TRUE(writer.open(path));
+    const uint32_t connection = writer.addConnection("/a", "std_msgs/UInt8", "", "");
+    const auto payload = makePayload(10, 1);
+    writer.writeMessage(connection, stamp, payload.data(), payload.size());
+  }
+
+  // Overwrite the payload size in the record header, such that the payload would reach past the end of the records.
+  std::vector<char> file;
+  {
+    std::ifstream input(path, std::ios::binary);
+    file.assign(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>());
+  }
+  const char* stampBytes = reinterpret_cast<const char*>(&stamp);
+  const auto stampIt = std::search(file.begin(), file.end(), stampBytes, stampBytes + sizeof(stamp));
+  ASSERT_NE(stampIt, file.end());
+  const uint32_t corruptSize = 1u << 30u;
+  std::memcpy(&*stampIt - offsetof(any_node::message_log::RecordHeader, stamp_) + offsetof(any_node::message_log::RecordHeader, size_),
+              &corruptSize, sizeof(corruptSize));
+  {
+    std::ofstream output(path, std::ios::binary | std::ios::trunc);
+    output.write(file.data(), static_cast<std::streamsize>(file.size()));
+  }
+
+  any_node::MessageLogReader reader;
+  ASSERT_TRUE(reader.open(path));
+  ASSERT_EQ(reader.getNumMessages(), 1u);
+  const auto message = reader.getMessage(0);
+  EXPECT_EQ(message.data_, nullptr);
+  EXPECT_EQ(message.size_, 0u);
+  EXPECT_EQ(reader.getMessage(1).data_, nullptr);
+
+  reader.close();
+  std::remove(path.c_str());
+}
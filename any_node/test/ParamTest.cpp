@@ -0,0 +1,72 @@
+// std
+#include <memory>
+#include <string>
+
+// gtest
+#include <gtest/gtest.h>
+
+// ros
+#include <rclcpp/rclcpp.hpp>
+
+// any node
+#include "any_node/Node.hpp"
+#include "any_node/Param.hpp"
+#include "any_node/QosParam.hpp"
+
+namespace {
+
+class TestNode : public any_node::Node {
+ public:
+  using any_node::Node::Node;
+  bool init() override { return true; }
+  void cleanup() override {}
+};
+
+class ParamTest : public ::testing::Test {
+ protected:
+  void SetUp() override { rclcpp::init(0, nullptr); }
+  void TearDown() override { rclcpp::shutdown(); }
+};
+
+}  // namespace
+
+TEST_F(ParamTest, OverrideReachesOptionalParameter) {  // NOLINT
+  // The node does not declare its parameters from the overrides.
+  auto node = std::make_shared<rclcpp::Node>("param_test", rclcpp::NodeOptions().parameter_overrides({{"executor.type", "multi"}}));
+  auto& parameterInterface = *node->get_node_parameters_interface();
+
+  std::string type = "single";
+  EXPECT_TRUE(any_node::getOptionalParameter(parameterInterface, "executor.type", type));
+  EXPECT_EQ(type, "multi");
+  // Read again once declared.
+  type = "single";
+  EXPECT_TRUE(any_node::getOptionalParameter(parameterInterface, "executor.type", type));
+  EXPECT_EQ(type, "multi");
+
+  int priority = 7;
+  EXPECT_FALSE(any_node::getOptionalParameter(parameterInterface, "executor.priority", priority));
+  EXPECT_EQ(priority, 7);
+}
+
+TEST_F(ParamTest, OverrideReachesWorkerOptions) {  // NOLINT
+  const rclcpp::NodeOptions nodeOptions = rclcpp::NodeOptions().parameter_overrides(
+      {{"workers.test_worker.time_step", 0.05}, {"workers.test_worker.priority", 42}, {"workers.test_worker.policy", "rr"}});
+  TestNode testNode(std::make_shared<rclcpp::Node>("param_test", nodeOptions));
+
+  const auto callback = [](const any_worker::WorkerEvent& /*event*/) { return true; };
+  const any_worker::WorkerOptions options = testNode.loadWorkerOptions(any_worker::WorkerOptions("test_worker", 0.01, callback));
+  EXPECT_DOUBLE_EQ(options.timeStep_, 0.05);
+  EXPECT_EQ(options.defaultPriority_, 42);
+  EXPECT_EQ(options.schedPolicy_, SCHED_RR);
+  EXPECT_EQ(options.schedAffinity_, -1);
+}
+
+TEST_F(ParamTest, OverrideReachesQos) {  // NOLINT
+  auto node = std::make_shared<rclcpp::Node>(
+      "param_test", rclcpp::NodeOptions().parameter_overrides({{"publishers.test.qos.reliability", "best_effort"},
+                                                               {"publishers.test.qos.depth", 7}}));
+
+  const rclcpp::QoS qos = any_node::getQosParameters(*node, "publishers.test", rclcpp::QoS(rclcpp::KeepLast(1)));
+  EXPECT_EQ(qos.reliability(), rclcpp::ReliabilityPolicy::BestEffort);
+  EXPECT_EQ(qos.depth(), 7u);
+}
@@ -0,0 +1,105 @@
+// std
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// any node
+#include "any_node/RealtimeProfile.hpp"
+
+namespace {
+
+//! Fake root directory with the files read by the real-time profile.
+class FakeRoot {
+ public:
+  FakeRoot() {
+    char pathTemplate[] = "/tmp/realtime_profile_test_XXXXXX";
+    path_ = mkdtemp(pathTemplate);
+  }
+
+  ~FakeRoot() { std::system(("rm -rf " + path_).c_str()); }
+
+  void writeFile(const std::string& path, const std::string& content) const {
+    const std::string fullPath = path_ + path;
+    std::system(("mkdir -p " + fullPath.substr(0, fullPath.rfind('/'))).c_str());
+    std::ofstream file(fullPath);
+    file << content;
+  }
+
+  const std::string& getPath() const { return path_; }
+
+ private:
+  std::string path_;
+};
+
+}  // namespace
+
+TEST(RealtimeProfile, ParseCpuList) {  // NOLINT
+  std::vector<int> cpus;
+  EXPECT_TRUE(any_node::RealtimeProfile::parseCpuList("", cpus));
+  EXPECT_TRUE(cpus.empty());
+  EXPECT_TRUE(any_node::RealtimeProfile::parseCpuList("5,0-2, 2", cpus));
+  EXPECT_EQ(cpus, std::vector<int>({0, 1, 2, 5}));
+  EXPECT_FALSE(any_node::RealtimeProfile::parseCpuList("3-1", cpus));
+  EXPECT_FALSE(any_node::RealtimeProfile::parseCpuList("a", cpus));
+  EXPECT_FALSE(any_node::RealtimeProfile::parseCpuList("1-2-3", cpus));
+}
+
+TEST(RealtimeProfile, Check) {  // NOLINT
+  FakeRoot root;
+  root.writeFile("/sys/devices/system/cpu/online", "0-3\n");
+  root.writeFile("/sys/devices/system/cpu/isolated", "2-3\n");
+  for (int cpu = 0; cpu < 4; cpu++) {
+    const std::string governor = (cpu == 1) ? "powersave\n" : "performance\n";
+    root.writeFile("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cpufreq/scaling_governor", governor);
+  }
+  root.writeFile("/proc/irq/10/smp_affinity_list", "0-1\n");
+  root.writeFile("/proc/irq/11/smp_affinity_list", "0-3\n");
+
+  any_node::RealtimeProfileOptions options;
+  options.governor_ = "performance";
+  options.isolatedCpus_ = "2-3";
+  EXPECT_TRUE(any_node::RealtimeProfile(options, root.getPath()).check());
+
+  // The governor of all online CPUs is checked if no CPUs are isolated.
+  options.isolatedCpus_ = "";
+  EXPECT_FALSE(any_node::RealtimeProfile(options, root.getPath()).check());
+
+  options.isolatedCpus_ = "1-2";
+  options.governor_ = "";
+  EXPECT_FALSE(any_node::RealtimeProfile(options, root.getPath()).check());
+
+  options.isolatedCpus_ = "3";
+  options.checkIrqAffinity_ = true;
+  EXPECT_FALSE(any_node::RealtimeProfile(options, root.getPath()).check());
+  root.writeFile("/proc/irq/11/smp_affinity_list", "0-2\n");
+  EXPECT_TRUE(any_node::RealtimeProfile(options, root.getPath()).check());
+}
+
+TEST(RealtimeProfile, Acquire) {  // NOLINT
+  FakeRoot root;
+  root.writeFile("/dev/cpu_dma_latency", "");
+
+  any_node::RealtimeProfileOptions options;
+  options.cpuDmaLatency_ = 0;
+  any_node::RealtimeProfile profile(options, root.getPath());
+  ASSERT_TRUE(profile.acquire());
+  EXPECT_TRUE(profile.isAcquired());
+  profile.release();
+  EXPECT_FALSE(profile.isAcquired());
+
+  std::ifstream file(root.getPath() + "/dev/cpu_dma_latency", std::ios::binary);
+  int32_t latency = -1;
+  file.read(reinterpret_cast<char*>(&latency), sizeof(latency));
+  EXPECT_EQ(latency, 0);
+
+  // Without a configured latency, nothing is requested.
+  any_node::RealtimeProfile disabledProfile(any_node::RealtimeProfileOptions(), root.getPath() + "/missing");
+  EXPECT_TRUE(disabledProfile.acquire());
+  EXPECT_FALSE(disabledProfile.isAcquired());
+}
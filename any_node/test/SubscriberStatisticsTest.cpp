@@ -0,0 +1,65 @@
+// std
+#include <chrono>
+#include <cmath>
+
+// gtest
+#include <gtest/gtest.h>
+
+// any node
+#include "any_node/SubscriberStatistics.hpp"
+
+TEST(RunningStatistics, Initialization) {  // NOLINT
+  any_node::RunningStatistics statistics;
+  EXPECT_EQ(statistics.getNumSamples(), 0u);
+  EXPECT_TRUE(std::isnan(statistics.getMean()));
+  EXPECT_TRUE(std::isnan(statistics.getStdDev()));
+  EXPECT_TRUE(std::isnan(statistics.getMin()));
+  EXPECT_TRUE(std::isnan(statistics.getMax()));
+}
+
+TEST(RunningStatistics, Samples) {  // NOLINT
+  any_node::RunningStatistics statistics;
+  for (const double sample : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0}) {
+    statistics.add(sample);
+  }
+  statistics.add(std::nan(""));
+
+  EXPECT_EQ(statistics.getNumSamples(), 8u);
+  EXPECT_DOUBLE_EQ(statistics.getMean(), 5.0);
+  EXPECT_DOUBLE_EQ(statistics.getVar(), 32.0 / 7.0);
+  EXPECT_DOUBLE_EQ(statistics.getMin(), 2.0);
+  EXPECT_DOUBLE_EQ(statistics.getMax(), 9.0);
+}
+
+TEST(SubscriberStatistics, RateJitterAndDrops) {  // NOLINT
+  any_node::SubscriberStatistics statistics("test");
+  auto time = any_node::SubscriberStatistics::Clock::now();
+
+  // Messages at 10 Hz, every second one 10 ms late.
+  for (unsigned int i = 0; i < 10; i++) {
+    const auto lateness = std::chrono::milliseconds((i % 2 == 0) ? 0 : 10);
+    statistics.addMessage(time + std::chrono::milliseconds(100 * i) + lateness, 0.01 * i);
+  }
+  statistics.addDrop();
+  statistics.addCallbackDuration(0.002);
+
+  EXPECT_EQ(statistics.getNumMessages(), 10u);
+  EXPECT_EQ(statistics.getNumDrops(), 1u);
+  EXPECT_NEAR(statistics.getRate(), 10.0, 0.2);
+  EXPECT_NEAR(statistics.getInterArrivalTime().getMax(), 0.11, 1e-9);
+  EXPECT_NEAR(statistics.getInterArrivalTime().getMin(), 0.09, 1e-9);
+  EXPECT_GT(statistics.getInterArrivalTime().getStdDev(), 0.0);
+  EXPECT_NEAR(statistics.getAge().getMax(), 0.09, 1e-9);
+  EXPECT_DOUBLE_EQ(statistics.getCallbackDuration().getMean(), 0.002);
+
+  statistics.reset();
+  EXPECT_EQ(statistics.getNumMessages(), 0u);
+  EXPECT_EQ(statistics.getNumDrops(), 0u);
+  EXPECT_TRUE(std::isnan(statistics.getRate()));
+}
+
+TEST(SubscriberStatistics, LatencyTracer) {  // NOLINT
+  auto tracer = std::make_shared<any_node::LatencyTracer>("test");
+  any_node::SubscriberStatistics statistics("test", tracer);
+  EXPECT_EQ(statistics.getLatencyTracer(), tracer);
+}
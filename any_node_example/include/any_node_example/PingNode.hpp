@@ -0,0 +1,58 @@
+/*!
+ * @file    PingNode.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+
+#include "any_node/LatencyHistogram.hpp"
+#include "any_node/Node.hpp"
+
+#include "any_node_example/PingPong.hpp"
+
+namespace any_node_example {
+
+/*!
+ * Latency benchmark together with the PongNode: A worker sends pings of a configurable payload size at a configurable rate, which the
+ * PongNode sends back. The node collects histograms of the round-trip latency and of the one-way latencies in both directions, and
+ * reports their percentiles periodically and on shutdown.
+ * The publishers are either plain ros publishers or ThreadedPublishers (parameter threaded), the worker priorities and the transport
+ * (parameter tcp_no_delay) are configurable as well, see param/ping_pong.yaml.
+ */
+class PingNode : public any_node::Node {
+ public:
+  PingNode() = delete;
+  explicit PingNode(any_node::Node::NodeHandlePtr nh) : any_node::Node(nh) {}
+
+  ~PingNode() override = default;
+
+  bool init() override;
+  void cleanup() override;
+
+  bool sendPing(const any_worker::WorkerEvent& event);
+  bool report(const any_worker::WorkerEvent& event);
+
+  void pongCallback(const std_msgs::UInt8MultiArrayConstPtr& msg);
+
+ protected:
+  void printReport();
+
+  unsigned int payloadSize_{0};
+  ros::Publisher pingPublisher_;
+  any_node::ThreadedPublisherPtr<std_msgs::UInt8MultiArray> threadedPingPublisher_;
+  ros::Subscriber pongSubscriber_;
+
+  std::mutex mutex_;
+  uint64_t numSent_{0};
+  uint64_t numReceived_{0};
+  //! Latencies in seconds.
+  any_node::LatencyHistogram roundTripLatency_;
+  any_node::LatencyHistogram pingLatency_;
+  any_node::LatencyHistogram pongLatency_;
+};
+
+}  // namespace any_node_example
@@ -0,0 +1,59 @@
+/*!
+ * @file    PingPong.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+
+#include <std_msgs/UInt8MultiArray.h>
+
+namespace any_node_example {
+
+/*!
+ * Layout of the ping and pong messages of the ping/pong benchmark (PingNode, PongNode). The payload starts with a header of three
+ * unsigned 64 bit integers, the rest is filler of the configured payload size:
+ *  - the sequence number of the ping,
+ *  - the time the ping was sent,
+ *  - the time the ping was received by the pong node.
+ * The times are in nanoseconds of the system clock, such that the one-way latencies are valid for nodes on the same host or on hosts
+ * with synchronized clocks (e.g. PTP).
+ */
+namespace ping_pong {
+
+enum class Field : unsigned int { Sequence = 0, PingTime, PongTime, NumFields };
+
+constexpr unsigned int HeaderSize = static_cast<unsigned int>(Field::NumFields) * sizeof(uint64_t);
+
+inline int64_t getTime() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+inline void resize(std_msgs::UInt8MultiArray& message, const unsigned int payloadSize) {
+  message.data.resize(std::max(payloadSize, HeaderSize));
+}
+
+//! Write a field, the message has to contain the header.
+inline void set(std_msgs::UInt8MultiArray& message, const Field field, const uint64_t value) {
+  std::memcpy(message.data.data() + static_cast<unsigned int>(field) * sizeof(uint64_t), &value, sizeof(value));
+}
+
+//! Read a field, the message has to contain the header.
+inline uint64_t get(const std_msgs::UInt8MultiArray& message, const Field field) {
+  uint64_t value = 0;
+  std::memcpy(&value, message.data.data() + static_cast<unsigned int>(field) * sizeof(uint64_t), sizeof(value));
+  return value;
+}
+
+inline bool hasHeader(const std_msgs::UInt8MultiArray& message) {
+  return message.data.size() >= HeaderSize;
+}
+
+}  // namespace ping_pong
+
+}  // namespace any_node_example
@@ -0,0 +1,37 @@
+/*!
+ * @file    PongNode.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+#include "any_node/Node.hpp"
+
+#include "any_node_example/PingPong.hpp"
+
+namespace any_node_example {
+
+/*!
+ * Counterpart of the PingNode: Stamps the received pings with their receive time and sends them back, either directly from the
+ * subscriber callback or through a ThreadedPublisher (parameter threaded).
+ */
+class PongNode : public any_node::Node {
+ public:
+  PongNode() = delete;
+  explicit PongNode(any_node::Node::NodeHandlePtr nh) : any_node::Node(nh) {}
+
+  ~PongNode() override = default;
+
+  bool init() override;
+  void cleanup() override;
+
+  void pingCallback(const std_msgs::UInt8MultiArrayConstPtr& msg);
+
+ protected:
+  ros::Publisher pongPublisher_;
+  any_node::ThreadedPublisherPtr<std_msgs::UInt8MultiArray> threadedPongPublisher_;
+  ros::Subscriber pingSubscriber_;
+};
+
+}  // namespace any_node_example
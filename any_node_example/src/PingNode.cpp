@@ -0,0 +1,104 @@
+/*!
+ * @file    PingNode.cpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#include <algorithm>
+
+#include "any_node_example/PingNode.hpp"
+
+namespace any_node_example {
+
+bool PingNode::init() {
+  const double rate = param<double>("rate", 100.0);
+  if (rate <= 0.0) {
+    MELO_ERROR("Ping node: The rate has to be positive, got %f.", rate);
+    return false;
+  }
+  payloadSize_ = static_cast<unsigned int>(std::max(param<int>("payload_size", 64), 0));
+  const bool threaded = param<bool>("threaded", false);
+  const auto queueSize = static_cast<unsigned int>(param<int>("queue_size", 100));
+  if (threaded) {
+    threadedPingPublisher_ =
+        threadedAdvertise<std_msgs::UInt8MultiArray>("ping", "/ping_pong/ping", queueSize, false, param<int>("buffer_size", 100));
+  } else {
+    pingPublisher_ = advertise<std_msgs::UInt8MultiArray>("ping", "/ping_pong/ping", queueSize);
+  }
+
+  ros::TransportHints transportHints;
+  if (param<bool>("tcp_no_delay", true)) {
+    transportHints.tcpNoDelay();
+  }
+  pongSubscriber_ = subscribe("pong", "/ping_pong/pong", queueSize, &PingNode::pongCallback, this, transportHints);
+
+  if (!addWorker("pingNode::sendPing", 1.0 / rate, &PingNode::sendPing, this, param<int>("priority", 0)) ||
+      !addWorker("pingNode::report", param<double>("report_time_step", 5.0), &PingNode::report, this, 0)) {
+    return false;
+  }
+
+  MELO_INFO("Ping node: Sending pings of %u bytes at %.1f Hz with %s publisher.", std::max(payloadSize_, ping_pong::HeaderSize), rate,
+            threaded ? "a threaded" : "a plain");
+  return true;
+}
+
+void PingNode::cleanup() {
+  if (threadedPingPublisher_) {
+    threadedPingPublisher_->shutdown();
+  }
+  printReport();
+}
+
+bool PingNode::sendPing(const any_worker::WorkerEvent& /*event*/) {
+  std_msgs::UInt8MultiArray ping;
+  ping_pong::resize(ping, payloadSize_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ping_pong::set(ping, ping_pong::Field::Sequence, numSent_++);
+  }
+  ping_pong::set(ping, ping_pong::Field::PingTime, static_cast<uint64_t>(ping_pong::getTime()));
+  if (threadedPingPublisher_) {
+    threadedPingPublisher_->publish(std::move(ping));
+  } else {
+    pingPublisher_.publish(ping);
+  }
+  return true;
+}
+
+bool PingNode::report(const any_worker::WorkerEvent& /*event*/) {
+  printReport();
+  return true;
+}
+
+void PingNode::pongCallback(const std_msgs::UInt8MultiArrayConstPtr& msg) {
+  const int64_t receiveTime = ping_pong::getTime();
+  if (!ping_pong::hasHeader(*msg)) {
+    MELO_WARN_THROTTLE(1.0, "Ping node: Received a pong without header.");
+    return;
+  }
+  const auto pingTime = static_cast<int64_t>(ping_pong::get(*msg, ping_pong::Field::PingTime));
+  const auto pongTime = static_cast<int64_t>(ping_pong::get(*msg, ping_pong::Field::PongTime));
+  std::lock_guard<std::mutex> lock(mutex_);
+  numReceived_++;
+  roundTripLatency_.add(static_cast<double>(receiveTime - pingTime) * 1e-9);
+  pingLatency_.add(static_cast<double>(pongTime - pingTime) * 1e-9);
+  pongLatency_.add(static_cast<double>(receiveTime - pongTime) * 1e-9);
+}
+
+void PingNode::printReport() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  MELO_INFO("Ping node: %lu pings sent, %lu pongs received.", numSent_, numReceived_);
+  const auto printLatency = [](const char* name, const any_node::LatencyHistogram& histogram) {
+    if (histogram.getNumSamples() == 0) {
+      return;
+    }
+    MELO_INFO("  %-10s [us]: mean %9.1f p50 %9.1f p90 %9.1f p99 %9.1f p99.9 %9.1f max %9.1f", name,
+              histogram.getStatistics().getMean() * 1e6, histogram.getPercentile(50.0) * 1e6, histogram.getPercentile(90.0) * 1e6,
+              histogram.getPercentile(99.0) * 1e6, histogram.getPercentile(99.9) * 1e6, histogram.getStatistics().getMax() * 1e6);
+  };
+  printLatency("round trip", roundTripLatency_);
+  printLatency("ping", pingLatency_);
+  printLatency("pong", pongLatency_);
+}
+
+}  // namespace any_node_example
@@ -0,0 +1,52 @@
+/*!
+ * @file    PongNode.cpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#include "any_node_example/PongNode.hpp"
+
+namespace any_node_example {
+
+bool PongNode::init() {
+  const bool threaded = param<bool>("threaded", false);
+  const auto queueSize = static_cast<unsigned int>(param<int>("queue_size", 100));
+  if (threaded) {
+    threadedPongPublisher_ =
+        threadedAdvertise<std_msgs::UInt8MultiArray>("pong", "/ping_pong/pong", queueSize, false, param<int>("buffer_size", 100));
+  } else {
+    pongPublisher_ = advertise<std_msgs::UInt8MultiArray>("pong", "/ping_pong/pong", queueSize);
+  }
+
+  ros::TransportHints transportHints;
+  if (param<bool>("tcp_no_delay", true)) {
+    transportHints.tcpNoDelay();
+  }
+  pingSubscriber_ = subscribe("ping", "/ping_pong/ping", queueSize, &PongNode::pingCallback, this, transportHints);
+
+  MELO_INFO("Pong node: Answering pings with %s publisher.", threaded ? "a threaded" : "a plain");
+  return true;
+}
+
+void PongNode::cleanup() {
+  if (threadedPongPublisher_) {
+    threadedPongPublisher_->shutdown();
+  }
+}
+
+void PongNode::pingCallback(const std_msgs::UInt8MultiArrayConstPtr& msg) {
+  const int64_t receiveTime = ping_pong::getTime();
+  if (!ping_pong::hasHeader(*msg)) {
+    MELO_WARN_THROTTLE(1.0, "Pong node: Received a ping without header.");
+    return;
+  }
+  std_msgs::UInt8MultiArray pong = *msg;
+  ping_pong::set(pong, ping_pong::Field::PongTime, static_cast<uint64_t>(receiveTime));
+  if (threadedPongPublisher_) {
+    threadedPongPublisher_->publish(std::move(pong));
+  } else {
+    pongPublisher_.publish(pong);
+  }
+}
+
+}  // namespace any_node_example
@@ -0,0 +1,8 @@
+#include "any_node/any_node.hpp"
+
+#include "any_node_example/PingNode.hpp"
+
+int main(int argc, char** argv) {
+  any_node::Nodewrap<any_node_example::PingNode> node(argc, argv, "pingNode", 2);  // use 2 spinner threads
+  return static_cast<int>(!node.execute());
+}
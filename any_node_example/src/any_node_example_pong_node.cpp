@@ -0,0 +1,8 @@
+#include "any_node/any_node.hpp"
+
+#include "any_node_example/PongNode.hpp"
+
+int main(int argc, char** argv) {
+  any_node::Nodewrap<any_node_example::PongNode> node(argc, argv, "pongNode", 2);  // use 2 spinner threads
+  return static_cast<int>(!node.execute());
+}
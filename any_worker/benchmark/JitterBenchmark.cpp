@@ -0,0 +1,296 @@
+/*!
+ * @file    JitterBenchmark.cpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ *
+ * Jitter regression harness: Runs a worker at rates from 100 Hz to 5 kHz in each scheduling mode, while background threads generate
+ * synthetic CPU, memory bandwidth and syscall load, and compares the percentiles of the wake-up latency (the time between the scheduled
+ * start of a cycle and the call of the callback) with budgets per scheduling mode.
+ * The results are printed as a table and optionally written to a CSV file, such that they can be tracked per release on the target
+ * hardware. The exit code is 1 if a budget is exceeded.
+ *
+ * Usage: any_worker_jitter_benchmark [options]
+ *   --duration <s>               duration per rate and mode, default 2.0
+ *   --cpu <n>                    number of CPU load threads, default 1
+ *   --memory <n>                 number of memory bandwidth load threads, default 1
+ *   --syscall <n>                number of syscall load threads, default 1
+ *   --priority <p>               SCHED_FIFO priority of the worker in the fifo mode, default 90
+ *   --affinity <cpu>             CPU of the worker, default none
+ *   --budget-other <p50,p99,max> budget in us for SCHED_OTHER, default 200,1000,5000
+ *   --budget-fifo <p50,p99,max>  budget in us for SCHED_FIFO, default 50,200,1000
+ *   --report <file>              CSV report
+ * The fifo mode needs the permission to set real-time priorities (e.g. CAP_SYS_NICE or an rtprio limit), it is reported as skipped
+ * otherwise.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "any_worker/Worker.hpp"
+
+#include "BenchmarkUtils.hpp"
+
+namespace {
+
+using any_worker::benchmark::getPercentile;
+
+using Clock = std::chrono::steady_clock;
+
+const std::vector<double> rates{100.0, 500.0, 1000.0, 2000.0, 5000.0};
+const std::vector<double> percentiles{50.0, 99.0, 100.0};
+
+struct Mode {
+  std::string name_;
+  int priority_{0};
+  //! Budgets of the percentiles in seconds.
+  std::vector<double> budgets_;
+};
+
+struct Options {
+  double duration_{2.0};
+  unsigned int numCpuThreads_{1};
+  unsigned int numMemoryThreads_{1};
+  unsigned int numSyscallThreads_{1};
+  int priority_{90};
+  int affinity_{-1};
+  std::vector<double> budgetsOther_{200e-6, 1000e-6, 5000e-6};
+  std::vector<double> budgetsFifo_{50e-6, 200e-6, 1000e-6};
+  std::string reportPath_;
+};
+
+bool parseBudgets(const std::string& text, std::vector<double>& budgets) {
+  std::vector<double> values;
+  size_t start = 0;
+  while (start <= text.size()) {
+    const size_t end = std::min(text.find(',', start), text.size());
+    char* parseEnd = nullptr;
+    const std::string value = text.substr(start, end - start);
+    values.push_back(std::strtod(value.c_str(), &parseEnd) * 1e-6);
+    if (value.empty() || *parseEnd != '\0') {
+      return false;
+    }
+    start = end + 1;
+  }
+  if (values.size() != percentiles.size()) {
+    return false;
+  }
+  budgets = values;
+  return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string key = argv[i];
+    const std::string value = argv[i + 1];
+    if (key == "--duration") {
+      options.duration_ = std::atof(value.c_str());
+    } else if (key == "--cpu") {
+      options.numCpuThreads_ = static_cast<unsigned int>(std::atoi(value.c_str()));
+    } else if (key == "--memory") {
+      options.numMemoryThreads_ = static_cast<unsigned int>(std::atoi(value.c_str()));
+    } else if (key == "--syscall") {
+      options.numSyscallThreads_ = static_cast<unsigned int>(std::atoi(value.c_str()));
+    } else if (key == "--priority") {
+      options.priority_ = std::atoi(value.c_str());
+    } else if (key == "--affinity") {
+      options.affinity_ = std::atoi(value.c_str());
+    } else if (key == "--budget-other") {
+      if (!parseBudgets(value, options.budgetsOther_)) {
+        return false;
+      }
+    } else if (key == "--budget-fifo") {
+      if (!parseBudgets(value, options.budgetsFifo_)) {
+        return false;
+      }
+    } else if (key == "--report") {
+      options.reportPath_ = value;
+    } else {
+      return false;
+    }
+  }
+  return argc % 2 == 1;
+}
+
+/*!
+ * Background threads generating load until destructed.
+ */
+class Load {
+ public:
+  Load(const unsigned int numCpuThreads, const unsigned int numMemoryThreads, const unsigned int numSyscallThreads) {
+    for (unsigned int i = 0; i < numCpuThreads; i++) {
+      threads_.emplace_back(&Load::generateCpuLoad, this);
+    }
+    for (unsigned int i = 0; i < numMemoryThreads; i++) {
+      threads_.emplace_back(&Load::generateMemoryLoad, this);
+    }
+    for (unsigned int i = 0; i < numSyscallThreads; i++) {
+      threads_.emplace_back(&Load::generateSyscallLoad, this);
+    }
+  }
+
+  ~Load() {
+    running_ = false;
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+ private:
+  void generateCpuLoad() {
+    volatile double value = 1.0;
+    while (running_) {
+      for (unsigned int i = 0; i < 10000; i++) {
+        value = std::sqrt(value + 1.0);
+      }
+    }
+  }
+
+  //! Copies buffers larger than the caches.
+  void generateMemoryLoad() {
+    constexpr size_t size = 64u * 1024u * 1024u;
+    std::vector<char> source(size, 1);
+    std::vector<char> destination(size);
+    while (running_) {
+      std::memcpy(destination.data(), source.data(), size);
+      source[destination[size - 1] % size]++;
+    }
+  }
+
+  void generateSyscallLoad() {
+    while (running_) {
+      for (unsigned int i = 0; i < 1000; i++) {
+        syscall(SYS_getppid);
+      }
+      sched_yield();
+    }
+  }
+
+  std::atomic<bool> running_{true};
+  std::vector<std::thread> threads_;
+};
+
+struct Result {
+  std::string mode_;
+  double rate_{0.0};
+  bool skipped_{false};
+  std::vector<double> latencies_;
+  std::vector<double> percentiles_;
+  bool withinBudget_{true};
+};
+
+Result run(const Mode& mode, const double rate, const Options& options) {
+  Result result;
+  result.mode_ = mode.name_;
+  result.rate_ = rate;
+  result.latencies_.reserve(static_cast<size_t>(rate * options.duration_ * 1.1) + 1);
+
+  std::atomic<int> policy{-1};
+  any_worker::WorkerOptions workerOptions(
+      "jitter", 1.0 / rate,
+      [&result, &policy](const any_worker::WorkerEvent& event) {
+        timespec now{};
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        if (policy < 0) {
+          sched_param sched{};
+          int currentPolicy = 0;
+          pthread_getschedparam(pthread_self(), &currentPolicy, &sched);
+          policy = currentPolicy;
+        }
+        result.latencies_.push_back(static_cast<double>(now.tv_sec - event.timeStamp.tv_sec) +
+                                    static_cast<double>(now.tv_nsec - event.timeStamp.tv_nsec) * 1e-9);
+        return true;
+      },
+      mode.priority_, options.affinity_);
+  // Late cycles are the subject of the benchmark, they are not worth a warning each.
+  workerOptions.maxTimeStepFactorWarning_ = 1e9;
+  workerOptions.maxTimeStepFactorError_ = 1e9;
+  {
+    any_worker::Worker worker(workerOptions);
+    worker.start();
+    std::this_thread::sleep_for(std::chrono::duration<double>(options.duration_));
+    worker.stop(true);
+  }
+
+  // The priority is applied after the thread started, the first cycle may have run with the default policy.
+  if (mode.priority_ != 0 && policy != SCHED_FIFO && policy >= 0) {
+    result.skipped_ = true;
+    return result;
+  }
+  std::sort(result.latencies_.begin(), result.latencies_.end());
+  for (unsigned int i = 0; i < percentiles.size(); i++) {
+    result.percentiles_.push_back(getPercentile(result.latencies_, percentiles[i]));
+    result.withinBudget_ = result.withinBudget_ && result.percentiles_.back() <= mode.budgets_[i];
+  }
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!parseOptions(argc, argv, options)) {
+    std::fprintf(stderr, "Invalid arguments, see the description in JitterBenchmark.cpp.\n");
+    return 2;
+  }
+  const std::vector<Mode> modes{{"other", 0, options.budgetsOther_}, {"fifo", options.priority_, options.budgetsFifo_}};
+
+  std::vector<Result> results;
+  {
+    Load load(options.numCpuThreads_, options.numMemoryThreads_, options.numSyscallThreads_);
+    for (const auto& mode : modes) {
+      for (const double rate : rates) {
+        results.push_back(run(mode, rate, options));
+      }
+    }
+  }
+
+  std::printf("Load: %u cpu, %u memory, %u syscall threads on %u CPUs, %.1f s per run\n\n", options.numCpuThreads_,
+              options.numMemoryThreads_, options.numSyscallThreads_, std::thread::hardware_concurrency(), options.duration_);
+  std::printf("%8s %10s | %10s %10s %10s %10s | %s\n", "mode", "rate [Hz]", "cycles", "p50 [us]", "p99 [us]", "max [us]", "budget");
+  bool withinBudget = true;
+  for (const auto& result : results) {
+    if (result.skipped_) {
+      std::printf("%8s %10.0f | %10s %10s %10s %10s | %s\n", result.mode_.c_str(), result.rate_, "-", "-", "-", "-",
+                  "skipped (no permission for real-time priority)");
+      continue;
+    }
+    std::printf("%8s %10.0f | %10zu %10.1f %10.1f %10.1f | %s\n", result.mode_.c_str(), result.rate_, result.latencies_.size(),
+                result.percentiles_[0] * 1e6, result.percentiles_[1] * 1e6, result.percentiles_[2] * 1e6,
+                result.withinBudget_ ? "ok" : "EXCEEDED");
+    withinBudget = withinBudget && result.withinBudget_;
+  }
+
+  if (!options.reportPath_.empty()) {
+    FILE* report = std::fopen(options.reportPath_.c_str(), "w");
+    if (report == nullptr) {
+      std::fprintf(stderr, "Failed to open %s: %s\n", options.reportPath_.c_str(), std::strerror(errno));
+      return 2;
+    }
+    std::fprintf(report, "mode,rate,cycles,p50,p99,max,budget_p50,budget_p99,budget_max,within_budget\n");
+    for (const auto& result : results) {
+      if (result.skipped_) {
+        continue;
+      }
+      const auto& budgets = result.mode_ == "fifo" ? options.budgetsFifo_ : options.budgetsOther_;
+      std::fprintf(report, "%s,%.0f,%zu,%.9f,%.9f,%.9f,%.9f,%.9f,%.9f,%d\n", result.mode_.c_str(), result.rate_, result.latencies_.size(),
+                   result.percentiles_[0], result.percentiles_[1], result.percentiles_[2], budgets[0], budgets[1], budgets[2],
+                   static_cast<int>(result.withinBudget_));
+    }
+    std::fclose(report);
+  }
+  return withinBudget ? 0 : 1;
+}
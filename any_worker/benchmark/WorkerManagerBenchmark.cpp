@@ -0,0 +1,261 @@
+/*!
+ * @file    WorkerManagerBenchmark.cpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ *
+ * Scalability and churn stress benchmark of the WorkerManager. A set of stable workers runs at mixed rates while several threads
+ * concurrently add, cancel and retime workers of their own and add one-shot workers, which are removed with cleanDestructibleWorkers().
+ * The benchmark reports:
+ *  - the latency of the manager operations (percentiles), including the time spent waiting for the mutex of the manager,
+ *  - the number of threads and the resident memory of the process,
+ *  - the wake-up latency (jitter) of the stable workers while the manager is churned.
+ *
+ * Usage: any_worker_worker_manager_benchmark [number of stable workers, default 1000] [number of churn threads, default 4]
+ *                                            [duration in s, default 5.0]
+ * The workers log every start and termination, redirect stderr to keep the report readable.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "any_worker/WorkerManager.hpp"
+
+#include "BenchmarkUtils.hpp"
+
+namespace {
+
+using any_worker::benchmark::getPercentile;
+
+using Clock = std::chrono::steady_clock;
+
+//! Rates of the workers in Hz, the workers are distributed evenly.
+const std::vector<double> rates{10.0, 100.0, 500.0, 1000.0};
+
+enum class Operation : unsigned int { Add = 0, Cancel, SetTimestep, AddOneShot, CleanDestructible, NumOperations };
+
+const char* getOperationName(const Operation operation) {
+  switch (operation) {
+    case Operation::Add:
+      return "add";
+    case Operation::Cancel:
+      return "cancel";
+    case Operation::SetTimestep:
+      return "setTimestep";
+    case Operation::AddOneShot:
+      return "add one-shot";
+    case Operation::CleanDestructible:
+      return "clean";
+    default:
+      return "";
+  }
+}
+
+/*!
+ * Wake-up latencies of a worker in seconds, i.e. the time between the scheduled start of a cycle and the call of the callback.
+ * Only written by the worker thread, read after the worker was cancelled.
+ */
+struct JitterRecorder {
+  double rate_{0.0};
+  std::vector<double> latencies_;
+
+  bool record(const any_worker::WorkerEvent& event) {
+    timespec now{};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    latencies_.push_back(static_cast<double>(now.tv_sec - event.timeStamp.tv_sec) +
+                         static_cast<double>(now.tv_nsec - event.timeStamp.tv_nsec) * 1e-9);
+    return true;
+  }
+};
+
+//! Latencies of the manager operations in seconds, by operation.
+using OperationLatencies = std::vector<std::vector<double>>;
+
+struct ProcessStatus {
+  unsigned int numThreads_{0};
+  //! Resident memory in kB.
+  unsigned int residentMemory_{0};
+};
+
+ProcessStatus readProcessStatus() {
+  ProcessStatus status;
+  std::ifstream file("/proc/self/status");
+  std::string key;
+  while (file >> key) {
+    if (key == "Threads:") {
+      file >> status.numThreads_;
+    } else if (key == "VmRSS:") {
+      file >> status.residentMemory_;
+    }
+    file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  }
+  return status;
+}
+
+void printLatencies(const char* name, std::vector<double>& latencies) {
+  std::sort(latencies.begin(), latencies.end());
+  std::printf("%16s | %10zu %10.1f %10.1f %10.1f %10.1f\n", name, latencies.size(), getPercentile(latencies, 50.0) * 1e6,
+              getPercentile(latencies, 90.0) * 1e6, getPercentile(latencies, 99.0) * 1e6,
+              latencies.empty() ? 0.0 : latencies.back() * 1e6);
+}
+
+template <typename Function>
+void measure(OperationLatencies& latencies, const Operation operation, Function function) {
+  const auto start = Clock::now();
+  function();
+  latencies[static_cast<unsigned int>(operation)].push_back(std::chrono::duration<double>(Clock::now() - start).count());
+}
+
+/*!
+ * Churn the manager with random operations on workers owned by this thread until stopped.
+ */
+OperationLatencies churn(any_worker::WorkerManager& manager, const unsigned int threadIndex, const std::atomic<bool>& running) {
+  OperationLatencies latencies(static_cast<unsigned int>(Operation::NumOperations));
+  std::mt19937 generator(threadIndex);
+  std::uniform_int_distribution<unsigned int> operationDistribution(0, static_cast<unsigned int>(Operation::NumOperations) - 1);
+  std::uniform_int_distribution<size_t> rateDistribution(0, rates.size() - 1);
+  const auto callback = [](const any_worker::WorkerEvent& /*event*/) { return true; };
+
+  std::vector<std::string> workers;
+  unsigned int numAdded = 0;
+  while (running) {
+    const auto operation = static_cast<Operation>(operationDistribution(generator));
+    switch (operation) {
+      case Operation::Add: {
+        const std::string name = "churn_" + std::to_string(threadIndex) + "_" + std::to_string(numAdded++);
+        any_worker::WorkerOptions options(name, 1.0 / rates[rateDistribution(generator)], callback);
+        measure(latencies, operation, [&]() { manager.addWorker(options); });
+        workers.push_back(name);
+        break;
+      }
+      case Operation::Cancel:
+        if (!workers.empty()) {
+          std::uniform_int_distribution<size_t> workerDistribution(0, workers.size() - 1);
+          const size_t index = workerDistribution(generator);
+          measure(latencies, operation, [&]() { manager.cancelWorker(workers[index]); });
+          workers[index] = workers.back();
+          workers.pop_back();
+        }
+        break;
+      case Operation::SetTimestep:
+        if (!workers.empty()) {
+          std::uniform_int_distribution<size_t> workerDistribution(0, workers.size() - 1);
+          const std::string& name = workers[workerDistribution(generator)];
+          const double timeStep = 1.0 / rates[rateDistribution(generator)];
+          measure(latencies, operation, [&]() { manager.setWorkerTimestep(name, timeStep); });
+        }
+        break;
+      case Operation::AddOneShot: {
+        any_worker::WorkerOptions options("one_shot_" + std::to_string(threadIndex) + "_" + std::to_string(numAdded++),
+                                          std::numeric_limits<double>::infinity(), callback);
+        options.destructWhenDone_ = true;
+        measure(latencies, operation, [&]() { manager.addWorker(options); });
+        break;
+      }
+      case Operation::CleanDestructible:
+        measure(latencies, operation, [&]() { manager.cleanDestructibleWorkers(); });
+        break;
+      default:
+        break;
+    }
+  }
+
+  for (const auto& name : workers) {
+    manager.cancelWorker(name);
+  }
+  return latencies;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const unsigned int numStableWorkers = argc > 1 ? static_cast<unsigned int>(std::atoi(argv[1])) : 1000;
+  const unsigned int numChurnThreads = argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2])) : 4;
+  const double duration = argc > 3 ? std::atof(argv[3]) : 5.0;
+
+  const ProcessStatus initialStatus = readProcessStatus();
+  OperationLatencies latencies(static_cast<unsigned int>(Operation::NumOperations));
+  std::vector<std::shared_ptr<JitterRecorder>> recorders;
+  ProcessStatus maxStatus = initialStatus;
+  ProcessStatus stableStatus;
+  {
+    any_worker::WorkerManager manager;
+
+    // Start the stable workers.
+    for (unsigned int i = 0; i < numStableWorkers; i++) {
+      auto recorder = std::make_shared<JitterRecorder>();
+      recorder->rate_ = rates[i % rates.size()];
+      recorder->latencies_.reserve(static_cast<size_t>(recorder->rate_ * (duration + 1.0)));
+      any_worker::WorkerOptions options("stable_" + std::to_string(i), 1.0 / recorder->rate_,
+                                        [recorder](const any_worker::WorkerEvent& event) { return recorder->record(event); });
+      // The stable workers are expected to be late under churn, the errors are counted by their rates anyway.
+      options.maxTimeStepFactorWarning_ = std::numeric_limits<double>::max();
+      measure(latencies, Operation::Add, [&]() { manager.addWorker(options); });
+      recorders.push_back(std::move(recorder));
+    }
+    stableStatus = readProcessStatus();
+
+    // Churn the manager and sample the process status.
+    std::atomic<bool> running{true};
+    std::vector<OperationLatencies> churnLatencies(numChurnThreads);
+    std::vector<std::thread> churnThreads;
+    for (unsigned int i = 0; i < numChurnThreads; i++) {
+      churnThreads.emplace_back([&, i]() { churnLatencies[i] = churn(manager, i, running); });
+    }
+    const auto end = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(duration));
+    while (Clock::now() < end) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      const ProcessStatus status = readProcessStatus();
+      maxStatus.numThreads_ = std::max(maxStatus.numThreads_, status.numThreads_);
+      maxStatus.residentMemory_ = std::max(maxStatus.residentMemory_, status.residentMemory_);
+    }
+    running = false;
+    for (auto& thread : churnThreads) {
+      thread.join();
+    }
+    for (const auto& threadLatencies : churnLatencies) {
+      for (unsigned int i = 0; i < threadLatencies.size(); i++) {
+        latencies[i].insert(latencies[i].end(), threadLatencies[i].begin(), threadLatencies[i].end());
+      }
+    }
+
+    measure(latencies, Operation::Cancel, [&]() { manager.cancelWorkers(); });
+  }
+  const ProcessStatus finalStatus = readProcessStatus();
+
+  std::printf("%u stable workers, %u churn threads, %.1f s\n\n", numStableWorkers, numChurnThreads, duration);
+  std::printf("%16s | %10s %10s %10s %10s %10s\n", "operation", "count", "p50 [us]", "p90 [us]", "p99 [us]", "max [us]");
+  for (unsigned int i = 0; i < latencies.size(); i++) {
+    printLatencies(getOperationName(static_cast<Operation>(i)), latencies[i]);
+  }
+  std::printf("(the last cancel is the cancellation of all workers)\n\n");
+
+  std::printf("%16s | %10s %10s\n", "process", "threads", "RSS [kB]");
+  std::printf("%16s | %10u %10u\n", "initial", initialStatus.numThreads_, initialStatus.residentMemory_);
+  std::printf("%16s | %10u %10u\n", "stable workers", stableStatus.numThreads_, stableStatus.residentMemory_);
+  std::printf("%16s | %10u %10u\n", "max under churn", maxStatus.numThreads_, maxStatus.residentMemory_);
+  std::printf("%16s | %10u %10u\n\n", "final", finalStatus.numThreads_, finalStatus.residentMemory_);
+
+  std::printf("%16s | %10s %10s %10s %10s %10s\n", "jitter", "count", "p50 [us]", "p90 [us]", "p99 [us]", "max [us]");
+  for (const double rate : rates) {
+    std::vector<double> rateLatencies;
+    for (const auto& recorder : recorders) {
+      if (recorder->rate_ == rate) {
+        rateLatencies.insert(rateLatencies.end(), recorder->latencies_.begin(), recorder->latencies_.end());
+      }
+    }
+    printLatencies((std::to_string(static_cast<int>(rate)) + " Hz").c_str(), rateLatencies);
+  }
+  return 0;
+}
@@ -42,10 +42,12 @@
 #pragma once
 
 // std
+#include <atomic>
 #include <ctime>
 
 // any worker
 #include "any_worker/RateOptions.hpp"
+#include "any_worker/RunningStatistics.hpp"
 
 namespace any_worker {
 
@@ -93,22 +95,23 @@ class Rate {
   //! Point in time when the most recent step should have started.
   //! If the timing is fine, the step time is equal to the sleep end time.
   timespec stepTime_{};
+  //! True if the most recent sleep() started after the step time had passed.
+  bool isBehind_{false};
   //! Counter storing how many times sleep has been called.
-  unsigned int numTimeSteps_{0};
+  //! The counters are atomic such that they can be monitored from other threads.
+  std::atomic<unsigned int> numTimeSteps_{0};
   //! Counter storing how many times a time step took longer than the warning threshold.
-  unsigned int numWarnings_{0};
+  std::atomic<unsigned int> numWarnings_{0};
   //! Counter storing how many times a time step took longer than the error threshold, not considering warnings.
-  unsigned int numErrors_{0};
+  std::atomic<unsigned int> numErrors_{0};
   //! Point in time when the last warning message was printed.
   timespec lastWarningPrintTime_{};
   //! Point in time when the last error message was printed.
   timespec lastErrorPrintTime_{};
   //! Most recent time which elapsed between subsequent calls of sleep().
   double awakeTime_{0.0};
-  //! Mean of the time which elapsed between subsequent calls of sleep().
-  double awakeTimeMean_{0.0};
-  //! Helper variable to compute the variance of the time step which elapsed between subsequent calls of sleep().
-  double awakeTimeM2_{0.0};
+  //! Mean and variance of the time which elapsed between subsequent calls of sleep().
+  RunningStatistics awakeTimeStatistics_;
 
  public:
   /*!
@@ -149,6 +152,12 @@ class Rate {
    */
   void reset();
 
+  /*!
+   * Restart the step time without resetting the statistics.
+   * Used to continue after a pause without catching up on the missed time steps.
+   */
+  void restartStepTime();
+
   /*!
    * Sleep for the rest of the time step.
    */
@@ -172,6 +181,18 @@ class Rate {
    */
   const timespec& getStepTime() const { return stepTime_; }
 
+  /*!
+   * Get the time when the next step should start, i.e. the deadline of the current step.
+   * @return Time when the next step should start.
+   */
+  timespec getNextStepTime() const;
+
+  /*!
+   * Check if the most recent sleep() was called too late to start the current step on time.
+   * @return True if behind schedule.
+   */
+  bool isBehind() const { return isBehind_; }
+
   /*!
    * Get the number of time steps.
    * @return Number of time steps.
@@ -225,7 +246,7 @@ class Rate {
   /*!
    * Add a duration to a time point.
    * @param time     Time point.
-   * @param duration Duration to add in seconds.
+   * @param duration Duration to add in seconds, can be negative.
    */
   static void AddDuration(timespec& time, const double duration);  // NOLINT(readability-identifier-naming)
 };
@@ -0,0 +1,62 @@
+/*!
+ * @file    RunningStatistics.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+// c++
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace any_worker {
+
+/*!
+ * Running mean, variance, minimum and maximum of a series of samples in constant memory.
+ * The algorithm is described here: https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
+ * Not thread-safe, the owner is responsible for the synchronization.
+ */
+class RunningStatistics {
+ public:
+  /*!
+   * Add a sample, NaN samples are ignored.
+   * @param sample Sample to add.
+   */
+  void add(const double sample) {
+    if (std::isnan(sample)) {
+      return;
+    }
+    numSamples_++;
+    const double delta = sample - mean_;
+    mean_ += delta / numSamples_;
+    const double delta2 = sample - mean_;
+    m2_ += delta * delta2;
+    min_ = std::min(min_, sample);
+    max_ = std::max(max_, sample);
+  }
+
+  void reset() { *this = RunningStatistics(); }
+
+  unsigned int getNumSamples() const { return numSamples_; }
+
+  double getMean() const { return (numSamples_ == 0) ? std::numeric_limits<double>::quiet_NaN() : mean_; }
+
+  double getVar() const { return (numSamples_ <= 1) ? std::numeric_limits<double>::quiet_NaN() : m2_ / (numSamples_ - 1); }
+
+  double getStdDev() const { return std::sqrt(getVar()); }
+
+  double getMin() const { return (numSamples_ == 0) ? std::numeric_limits<double>::quiet_NaN() : min_; }
+
+  double getMax() const { return (numSamples_ == 0) ? std::numeric_limits<double>::quiet_NaN() : max_; }
+
+ private:
+  unsigned int numSamples_{0};
+  double mean_{0.0};
+  double m2_{0.0};
+  double min_{std::numeric_limits<double>::infinity()};
+  double max_{-std::numeric_limits<double>::infinity()};
+};
+
+}  // namespace any_worker
@@ -0,0 +1,97 @@
+/*!
+ * @file    ThreadPool.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace any_worker {
+
+/*!
+ * Fixed number of threads executing tasks from a shared queue in FIFO order.
+ * The queue can be bounded, in which case tasks submitted to a full queue are rejected (load shedding).
+ */
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  ThreadPool() = delete;
+
+  /*!
+   * Starts the threads.
+   * @param name          name of the pool, used for printing
+   * @param numThreads    number of threads, at least one thread is started
+   * @param maxQueueSize  maximum number of queued tasks which are not executed yet, 0 means unbounded
+   * @param priority      SCHED_FIFO priority of the threads (0 to 99), 0 keeps the default scheduling
+   */
+  ThreadPool(std::string name, const unsigned int numThreads, const unsigned int maxQueueSize = 0, const int priority = 0);
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  virtual ~ThreadPool();
+
+  /*!
+   * Queue a task for execution.
+   * @param task  task to execute
+   * @return      false if the task was rejected because the queue is full or the pool is stopped
+   */
+  bool submit(Task task);
+
+  /*!
+   * Stops accepting tasks, executes the tasks which are already queued and joins the threads.
+   * @param timeout  time in seconds to wait for the threads. Threads which are still busy after it (e.g. blocked in a task which cannot
+   *                 be aborted) are detached and abandoned, they terminate once their task returns.
+   * @return         true if all threads terminated, false if threads were abandoned
+   */
+  bool stop(const double timeout = std::numeric_limits<double>::infinity());
+
+  const std::string& getName() const { return name_; }
+  unsigned int getNumThreads() const { return static_cast<unsigned int>(threads_.size()); }
+  unsigned int getMaxQueueSize() const { return maxQueueSize_; }
+
+  unsigned int getQueueSize() const;
+  unsigned int getNumActive() const { return state_->numActive_; }
+  unsigned int getNumExecuted() const { return state_->numExecuted_; }
+  unsigned int getNumRejected() const { return state_->numRejected_; }
+
+ private:
+  /*!
+   * State shared with the threads, such that abandoned threads can outlive the pool.
+   */
+  struct State {
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Task> tasks_;
+    bool stopRequested_{false};
+    //! Number of threads which did not return from run() yet.
+    unsigned int numRunningThreads_{0};
+    std::condition_variable terminatedCv_;
+
+    std::atomic<unsigned int> numActive_{0};
+    std::atomic<unsigned int> numExecuted_{0};
+    std::atomic<unsigned int> numRejected_{0};
+  };
+
+  static void run(const std::shared_ptr<State>& state);
+
+  const std::string name_;
+  const unsigned int maxQueueSize_;
+
+  const std::shared_ptr<State> state_{std::make_shared<State>()};
+  std::vector<std::thread> threads_;
+  unsigned int numAbandonedThreads_{0};
+};
+
+}  // namespace any_worker
@@ -43,8 +43,10 @@
 
 #include <atomic>
 #include <functional>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "any_worker/Rate.hpp"
 #include "any_worker/WorkerEvent.hpp"
@@ -77,12 +79,66 @@ class Worker {
   void setTimestep(const double timeStep);
   void setEnforceRate(const bool enforceRate);
 
+  /*!
+   * Change the scheduling policy and priority of the underlying thread. Applied immediately if the worker is running and kept for later
+   * starts. Can be called from any thread, including the worker itself.
+   * @param priority  priority within the range of the policy, e.g. 1 to 99 for SCHED_FIFO and 0 for SCHED_OTHER.
+   * @param policy    scheduling policy (SCHED_FIFO, SCHED_RR, SCHED_OTHER, SCHED_BATCH or SCHED_IDLE).
+   * @return true if successful.
+   */
+  bool setPriority(const int priority, const int policy);
+
+  /*!
+   * Change the priority of the underlying thread, keeping the current scheduling policy (see setPriority(priority, policy)).
+   * @param priority  priority within the range of the current policy.
+   * @return true if successful.
+   */
+  bool setPriority(const int priority);
+
+  /*!
+   * Change the CPUs the underlying thread may run on. Applied immediately if the worker is running and kept for later starts, replacing
+   * the CPU set and the affinity of the options. Can be called from any thread, including the worker itself.
+   * @param cpus  CPUs, an empty set releases the thread to all CPUs.
+   * @return true if successful.
+   */
+  bool setCpuSet(const std::vector<int>& cpus);
+
   const std::string& getName() const { return options_.name_; }
+  double getTimestep() const { return options_.timeStep_; }
+  WorkerCriticality getCriticality() const { return options_.criticality_; }
   const Rate& getRate() const { return rate_; }
   Rate& getRate() { return rate_; }
 
   bool isRunning() const { return running_; }
 
+  /*!
+   * @return true if the worker is running but parked because its activation condition is not fulfilled.
+   */
+  bool isParked() const { return parked_; }
+
+  /*!
+   * Suspend or resume the worker. A suspended worker is parked like a worker whose activation condition is not fulfilled.
+   * @param suspended true to suspend, false to resume.
+   */
+  void setSuspended(const bool suspended) { suspended_ = suspended; }
+
+  bool isSuspended() const { return suspended_; }
+
+  /*!
+   * @return number of times the callback returned false since the worker was constructed.
+   */
+  unsigned int getNumFailures() const { return numFailures_; }
+
+  /*!
+   * @return number of times the callback returned false in a row.
+   */
+  unsigned int getNumConsecutiveFailures() const { return numConsecutiveFailures_; }
+
+  /*!
+   * @return number of aggregated reports of the failures of the callback.
+   */
+  unsigned int getNumFailureReports() const { return numFailureReports_; }
+
   /*!
    * @return true if underlying thread has terminated and deleteWhenDone_ option is set.
    */
@@ -91,12 +147,62 @@ class Worker {
  private:
   void run();
 
+  /*!
+   * Counts and reports failures of the callback and calls the failure reaction according to the threshold and backoff of the options.
+   */
+  void handleCallbackResult(const bool success);
+
+  /*!
+   * Reports the failures of the callback since the last report, if any.
+   */
+  void reportFailures();
+
+  /*!
+   * Validate and store the scheduling policy and priority and apply them if running, the scheduling mutex has to be locked.
+   */
+  bool setScheduling(const int policy, const int priority);
+
+  /*!
+   * Apply the scheduling policy and priority or the CPU set to the running thread, the scheduling mutex has to be locked.
+   */
+  bool applyScheduling(const int policy, const int priority);
+  bool applyCpuSet(const std::vector<int>& cpus);
+
+  /*!
+   * @return event for the current cycle, with the deadline of the callback.
+   */
+  WorkerEvent createEvent() const;
+
+  /*!
+   * @return true if the worker is not suspended and no activation condition is set or the activation condition is fulfilled.
+   */
+  bool isActive() const;
+
+  /*!
+   * Blocks until the activation condition is fulfilled or the worker is stopped.
+   */
+  void waitForActivation();
+
  private:
   WorkerOptions options_;
 
   std::atomic<bool> running_{false};
   std::atomic<bool> done_{false};
-
+  std::atomic<bool> parked_{false};
+  std::atomic<bool> suspended_{false};
+
+  std::atomic<unsigned int> numFailures_{0};
+  std::atomic<unsigned int> numConsecutiveFailures_{0};
+  unsigned int numFailuresSinceReport_{0};
+  std::atomic<unsigned int> numFailureReports_{0};
+  timespec lastFailureReportTime_{0, 0};
+  //! Number of consecutive failures at which the failure reaction is called next.
+  unsigned int nextFailureReaction_{0};
+  //! Number of failures until the next failure reaction, doubled after every reaction up to the maximum backoff.
+  unsigned int failureReactionBackoff_{1};
+
+  //! Serializes the changes of the scheduling with starting and stopping the thread.
+  std::mutex mutexScheduling_;
   std::thread thread_;
   Rate rate_;
 };
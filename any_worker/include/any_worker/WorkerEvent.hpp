@@ -42,6 +42,8 @@
 #pragma once
 
 #include <sys/time.h>
+#include <ctime>
+#include <limits>
 
 namespace any_worker {
 
@@ -51,14 +53,42 @@ namespace any_worker {
 struct WorkerEvent {
   WorkerEvent() = default;
   WorkerEvent(const double dt, const timespec& time) : timeStep(dt), timeStamp(time) {}
+  WorkerEvent(const double dt, const timespec& time, const timespec& deadlineTime, const clockid_t clock, const bool isBehind)
+      : timeStep(dt), timeStamp(time), deadline(deadlineTime), clockId(clock), behind(isBehind) {}
   virtual ~WorkerEvent() = default;
 
+  /*!
+   * Time in seconds until the deadline, i.e. the budget which is left for the callback. Negative if the deadline has passed, infinity if
+   * the worker has no deadline. Costs one clock read, such that anytime algorithms can poll it.
+   */
+  double remainingBudget() const {
+    if (deadline.tv_sec == 0 && deadline.tv_nsec == 0) {
+      return std::numeric_limits<double>::infinity();
+    }
+    timespec now{};
+    clock_gettime(clockId, &now);
+    return static_cast<double>(deadline.tv_sec - now.tv_sec) + static_cast<double>(deadline.tv_nsec - now.tv_nsec) * 1e-9;
+  }
+
   /*!
    * The timestep between consecutive calls of the callback function. 0 if run only once.
    */
   double timeStep{0};  // NOLINT(readability-identifier-naming)
 
   timespec timeStamp{0, 0};  // NOLINT(readability-identifier-naming)
+
+  /*!
+   * Time by which the callback should return: The start of the next time step minus the safety margin of the worker, measured with
+   * clockId. Zero if the worker has no deadline (timestep of 0 or run only once).
+   */
+  timespec deadline{0, 0};  // NOLINT(readability-identifier-naming)
+
+  clockid_t clockId{CLOCK_MONOTONIC};  // NOLINT(readability-identifier-naming)
+
+  /*!
+   * True if the worker is behind schedule, i.e. the previous time step overran and the current one started late.
+   */
+  bool behind{false};  // NOLINT(readability-identifier-naming)
 };
 
 }  // namespace any_worker
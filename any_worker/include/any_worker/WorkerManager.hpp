@@ -6,16 +6,55 @@
 
 #pragma once
 
+#include <atomic>
 #include <functional>  // for std::bind
+#include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "any_worker/Worker.hpp"
 #include "any_worker/WorkerOptions.hpp"
 
 namespace any_worker {
 
+struct OverloadProtectionOptions {
+  enum class Reaction { Throttle, Park };
+
+  /*!
+   * time step in seconds of the check for overruns of the high-criticality workers.
+   */
+  double checkTimeStep_{0.1};
+
+  /*!
+   * number of overruns of high-criticality workers within a check, from which on the manager is overloaded. A time step overruns if its
+   * awake time exceeds the warning or error threshold of the rate.
+   */
+  unsigned int overrunThreshold_{1};
+
+  /*!
+   * time in seconds without overload after which one level of degradation is undone.
+   */
+  double recoveryTime_{1.0};
+
+  /*!
+   * reaction applied to the degraded workers: Throttle multiplies their time step by throttleFactor_, Park suspends them.
+   */
+  Reaction reaction_{Reaction::Throttle};
+
+  double throttleFactor_{2.0};
+
+  /*!
+   * scheduling policy and priority of the thread checking for overruns. It has to preempt the high-criticality workers, otherwise an
+   * overload of these starves the check and the degradation never takes effect.
+   */
+  int schedPolicy_{SCHED_FIFO};
+  int priority_{99};
+};
+
 class WorkerManager {
  public:
   WorkerManager();
@@ -71,14 +110,89 @@ class WorkerManager {
 
   void setWorkerTimestep(const std::string& name, const double timeStep);
 
+  /*!
+   * Suspend or resume a worker (see Worker::setSuspended(..)). The overload protection does not resume a worker suspended this way.
+   */
+  void setWorkerSuspended(const std::string& name, const bool suspended);
+
+  /*!
+   * Change the scheduling policy and priority of a worker, also while it is running (see Worker::setPriority(..)).
+   * @return true if successful.
+   */
+  bool setWorkerPriority(const std::string& name, const int priority, const int policy);
+
+  /*!
+   * Change the priority of a worker, keeping its current scheduling policy (see Worker::setPriority(..)).
+   * @return true if successful.
+   */
+  bool setWorkerPriority(const std::string& name, const int priority);
+
+  /*!
+   * Change the CPUs a worker may run on, also while it is running (see Worker::setCpuSet(..)).
+   * @return true if successful.
+   */
+  bool setWorkerCpuSet(const std::string& name, const std::vector<int>& cpus);
+
+  /*!
+   * Get the number of time steps which took longer than the error threshold of the rate, for all workers.
+   * @return Number of errors by worker name, ordered by name.
+   */
+  std::map<std::string, unsigned int> getNumRateErrors();
+
   /*!
    * Removes workers which are destructible (see Worker::isDestructible()) from the map (calling their destructors)
    */
   void cleanDestructibleWorkers();
 
+  /*!
+   * Start the overload protection: While high-criticality workers overrun, the workers of lower criticality are degraded step by step,
+   * first the low-criticality and then the normal-criticality workers. The degradation is undone step by step once no overruns occurred
+   * for the recovery time.
+   * @param options Options of the overload protection.
+   * @return true if successful.
+   */
+  bool enableOverloadProtection(const OverloadProtectionOptions& options = OverloadProtectionOptions());
+
+  /*!
+   * Stop the overload protection and restore the degraded workers.
+   */
+  void disableOverloadProtection();
+
+  /*!
+   * @return number of degraded criticality levels, 0 if not degraded, 1 if the low-criticality workers are degraded and 2 if also the
+   * normal-criticality workers are degraded.
+   */
+  int getNumDegradedLevels() const { return numDegradedLevels_; }
+
+
  private:
+  /*!
+   * Check for overruns of the high-criticality workers and adapt the degradation, called periodically by the overload protection.
+   */
+  void checkOverload();
+
+  /*!
+   * Join the threads of stopped workers taken out of the map and reinsert them, the mutex of the workers must not be locked.
+   */
+  void joinWorkers(std::unordered_map<std::string, Worker>& stoppedWorkers);
+
+  void setNumDegradedLevels(const int numDegradedLevels);
+  void degradeWorker(const std::string& name, Worker& worker);
+  void restoreWorker(const std::string& name, Worker& worker);
+
   std::unordered_map<std::string, Worker> workers_;
   std::mutex mutexWorkers_;
+
+  OverloadProtectionOptions overloadOptions_;
+  std::unique_ptr<Worker> overloadMonitor_;
+  std::atomic<int> numDegradedLevels_{0};
+  //! Overruns of the high-criticality workers at the previous check.
+  std::unordered_map<std::string, unsigned int> numOverruns_;
+  //! Undegraded time steps of the throttled workers.
+  std::unordered_map<std::string, double> throttledTimeSteps_;
+  //! Workers suspended by the overload protection, only these are resumed on restore.
+  std::unordered_set<std::string> suspendedWorkers_;
+  double timeWithoutOverload_{0.0};
 };
 
 }  // namespace any_worker
@@ -41,8 +41,11 @@
 
 #pragma once
 
+#include <sched.h>
 #include <atomic>
+#include <functional>
 #include <string>
+#include <vector>
 
 #include "any_worker/RateOptions.hpp"
 #include "any_worker/WorkerEvent.hpp"
@@ -51,6 +54,13 @@ namespace any_worker {
 
 using WorkerCallback = std::function<bool(const WorkerEvent&)>;
 using WorkerCallbackFailureReaction = std::function<void(void)>;
+using WorkerActivationCondition = std::function<bool(void)>;
+
+/*!
+ * Criticality of a worker. When high-criticality workers overrun, the WorkerManager can degrade the workers of lower criticality (see
+ * WorkerManager::enableOverloadProtection()).
+ */
+enum class WorkerCriticality : int { Low = 0, Normal = 1, High = 2 };
 
 struct WorkerOptions : public RateOptions {
   WorkerOptions() : callbackFailureReaction_([]() {}) {}
@@ -81,7 +91,16 @@ struct WorkerOptions : public RateOptions {
         callbackFailureReaction_(std::move(other.callbackFailureReaction_)),
         defaultPriority_(other.defaultPriority_),
         destructWhenDone_(other.destructWhenDone_),
-        schedAffinity_(other.schedAffinity_) {}
+        schedAffinity_(other.schedAffinity_),
+        schedPolicy_(other.schedPolicy_),
+        schedCpuSet_(std::move(other.schedCpuSet_)),
+        activationCondition_(std::move(other.activationCondition_)),
+        activationCheckTimeStep_(other.activationCheckTimeStep_),
+        deadlineSafetyMargin_(other.deadlineSafetyMargin_),
+        criticality_(other.criticality_),
+        failureReactionThreshold_(other.failureReactionThreshold_),
+        failureReactionMaxBackoff_(other.failureReactionMaxBackoff_),
+        failureReportInterval_(other.failureReportInterval_) {}
 
   /*!
    * The primary worker callback to be called
@@ -108,6 +127,55 @@ struct WorkerOptions : public RateOptions {
    * of "-1" means no affinity is set.
    */
   int schedAffinity_{-1};
+
+  /*!
+   * scheduling policy of the underlying thread (SCHED_FIFO, SCHED_RR, SCHED_OTHER, SCHED_BATCH or SCHED_IDLE). The real-time policies
+   * SCHED_FIFO and SCHED_RR are only applied with a priority other than 0.
+   */
+  int schedPolicy_{SCHED_FIFO};
+
+  /*!
+   * CPUs the underlying thread may run on. Takes precedence over schedAffinity_ if not empty.
+   */
+  std::vector<int> schedCpuSet_;
+
+  /*!
+   * optional condition which is checked before every cycle. While it returns false, the worker is parked: the callback is not executed and
+   * the condition is polled with activationCheckTimeStep_ instead of the worker timestep. An empty condition means always active.
+   */
+  WorkerActivationCondition activationCondition_;
+
+  /*!
+   * time step in seconds with which the activation condition is polled while the worker is parked.
+   */
+  double activationCheckTimeStep_{0.1};
+
+  /*!
+   * time in seconds subtracted from the start of the next time step to get the deadline passed to the callback (see
+   * WorkerEvent::remainingBudget()), to leave room for the work done after the callback returns.
+   */
+  double deadlineSafetyMargin_{0.0};
+
+  /*!
+   * criticality of the worker, high-criticality workers are protected from overload by degrading the others.
+   */
+  WorkerCriticality criticality_{WorkerCriticality::Normal};
+
+  /*!
+   * number of consecutive failures of the callback (returning false) after which the failure reaction is called.
+   */
+  unsigned int failureReactionThreshold_{1};
+
+  /*!
+   * maximum number of consecutive failures between two calls of the failure reaction. While the failures persist, the number of failures
+   * between the calls doubles from 1 up to this maximum. The default of 1 calls the reaction on every failure above the threshold.
+   */
+  unsigned int failureReactionMaxBackoff_{1};
+
+  /*!
+   * minimum time in seconds between two reports of failures of the callback, the failures in between are aggregated.
+   */
+  double failureReportInterval_{1.0};
 };
 
 }  // namespace any_worker
@@ -58,14 +58,14 @@ Rate::Rate(Rate&& other)
       sleepStartTime_(std::move(other.sleepStartTime_)),
       sleepEndTime_(std::move(other.sleepEndTime_)),
       stepTime_(std::move(other.stepTime_)),
-      numTimeSteps_(std::move(other.numTimeSteps_)),
-      numWarnings_(std::move(other.numWarnings_)),
-      numErrors_(std::move(other.numErrors_)),
+      isBehind_(other.isBehind_),
+      numTimeSteps_(other.numTimeSteps_.load()),
+      numWarnings_(other.numWarnings_.load()),
+      numErrors_(other.numErrors_.load()),
       lastWarningPrintTime_(std::move(other.lastWarningPrintTime_)),
       lastErrorPrintTime_(std::move(other.lastErrorPrintTime_)),
       awakeTime_(std::move(other.awakeTime_)),
-      awakeTimeMean_(std::move(other.awakeTimeMean_)),
-      awakeTimeM2_(std::move(other.awakeTimeM2_)) {
+      awakeTimeStatistics_(other.awakeTimeStatistics_) {
   reset();
 }
 
@@ -75,19 +75,23 @@ void Rate::reset() {
   numWarnings_ = 0;
   numErrors_ = 0;
   awakeTime_ = 0.0;
-  awakeTimeMean_ = 0.0;
-  awakeTimeM2_ = 0.0;
+  awakeTimeStatistics_.reset();
   lastWarningPrintTime_.tv_sec = 0;
   lastWarningPrintTime_.tv_nsec = 0;
   lastErrorPrintTime_.tv_sec = 0;
   lastErrorPrintTime_.tv_nsec = 0;
 
+  restartStepTime();
+}
+
+void Rate::restartStepTime() {
   // Update the sleep time to the current time.
   timespec now{};
   clock_gettime(options_.clockId_, &now);
   sleepStartTime_ = now;
   sleepEndTime_ = now;
   stepTime_ = now;
+  isBehind_ = false;
 }
 
 void Rate::sleep() {
@@ -95,13 +99,9 @@ void Rate::sleep() {
   clock_gettime(options_.clockId_, &sleepStartTime_);
   awakeTime_ = GetDuration(sleepEndTime_, sleepStartTime_);
 
-  // Update the statistics. The algorithm is described here:
-  // https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance
+  // Update the statistics.
   numTimeSteps_++;
-  const double delta = awakeTime_ - awakeTimeMean_;
-  awakeTimeMean_ += delta / numTimeSteps_;
-  const double delta2 = awakeTime_ - awakeTimeMean_;
-  awakeTimeM2_ += delta * delta2;
+  awakeTimeStatistics_.add(awakeTime_);
 
   if (options_.timeStep_ == 0.0) {
     sleepEndTime_ = sleepStartTime_;
@@ -132,8 +132,8 @@ void Rate::sleep() {
 
     // Get the current time again and check if the step time has already past.
     clock_gettime(options_.clockId_, &sleepEndTime_);
-    const bool isBehind = (GetDuration(sleepEndTime_, stepTime_) < 0.0);
-    if (isBehind) {
+    isBehind_ = (GetDuration(sleepEndTime_, stepTime_) < 0.0);
+    if (isBehind_) {
       if (!options_.enforceRate_) {
         // We are behind schedule but do not enforce the rate, so we increase the length of
         // the current time step by setting the desired step time to when sleep() ends.
@@ -152,6 +152,12 @@ void Rate::sleep() {
   }
 }
 
+timespec Rate::getNextStepTime() const {
+  timespec nextStepTime = stepTime_;
+  AddDuration(nextStepTime, options_.timeStep_);
+  return nextStepTime;
+}
+
 double Rate::getAwakeTime() const {
   if (numTimeSteps_ == 0) {
     return std::numeric_limits<double>::quiet_NaN();
@@ -161,23 +167,15 @@ double Rate::getAwakeTime() const {
 }
 
 double Rate::getAwakeTimeMean() const {
-  if (numTimeSteps_ == 0) {
-    return std::numeric_limits<double>::quiet_NaN();
-  } else {
-    return awakeTimeMean_;
-  }
+  return awakeTimeStatistics_.getMean();
 }
 
 double Rate::getAwakeTimeVar() const {
-  if (numTimeSteps_ <= 1) {
-    return std::numeric_limits<double>::quiet_NaN();
-  } else {
-    return awakeTimeM2_ / (numTimeSteps_ - 1);
-  }
+  return awakeTimeStatistics_.getVar();
 }
 
 double Rate::getAwakeTimeStdDev() const {
-  return std::sqrt(getAwakeTimeVar());
+  return awakeTimeStatistics_.getStdDev();
 }
 
 double Rate::GetDuration(const timespec& start, const timespec& end) {  // NOLINT(readability-identifier-naming)
@@ -188,6 +186,10 @@ void Rate::AddDuration(timespec& time, const double duration) {  // NOLINT(reada
   time.tv_nsec += static_cast<long int>(duration * NSecPerSec_);
   time.tv_sec += time.tv_nsec / NSecPerSec_;
   time.tv_nsec = time.tv_nsec % NSecPerSec_;
+  if (time.tv_nsec < 0) {
+    time.tv_sec--;
+    time.tv_nsec += NSecPerSec_;
+  }
 }
 
 }  // namespace any_worker
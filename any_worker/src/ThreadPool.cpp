@@ -0,0 +1,118 @@
+/*!
+ * @file    ThreadPool.cpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ */
+
+#include <pthread.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>  // strerror(..)
+
+#include "any_worker/ThreadPool.hpp"
+#include "message_logger/message_logger.hpp"
+
+namespace any_worker {
+
+ThreadPool::ThreadPool(std::string name, const unsigned int numThreads, const unsigned int maxQueueSize, const int priority)
+    : name_(std::move(name)), maxQueueSize_(maxQueueSize) {
+  state_->numRunningThreads_ = std::max(numThreads, 1u);
+  for (unsigned int i = 0; i < std::max(numThreads, 1u); i++) {
+    threads_.emplace_back(&ThreadPool::run, state_);
+    if (priority != 0) {
+      sched_param sched{};
+      sched.sched_priority = priority;
+      const int error = pthread_setschedparam(threads_.back().native_handle(), SCHED_FIFO, &sched);
+      if (error != 0) {
+        MELO_WARN("Failed to set thread priority for thread pool [%s]: %s", name_.c_str(), strerror(error));
+      }
+    }
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  stop();
+}
+
+bool ThreadPool::submit(Task task) {
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex_);
+    if (state_->stopRequested_ || (maxQueueSize_ != 0 && state_->tasks_.size() >= maxQueueSize_)) {
+      state_->numRejected_++;
+      return false;
+    }
+    state_->tasks_.push_back(std::move(task));
+  }
+  state_->cv_.notify_one();
+  return true;
+}
+
+bool ThreadPool::stop(const double timeout) {
+  // Do not wait for the thread calling from within a task of this pool.
+  const bool isPoolThread = std::any_of(threads_.begin(), threads_.end(),
+                                       [](const std::thread& thread) { return thread.get_id() == std::this_thread::get_id(); });
+  const unsigned int numOwnThreads = isPoolThread ? 1u : 0u;
+  bool terminated = true;
+  {
+    std::unique_lock<std::mutex> lock(state_->mutex_);
+    state_->stopRequested_ = true;
+    state_->cv_.notify_all();
+    // Threads abandoned by a previous call are not waited for again.
+    const auto isTerminated = [this, numOwnThreads]() { return state_->numRunningThreads_ <= numOwnThreads + numAbandonedThreads_; };
+    if (std::isinf(timeout)) {
+      state_->terminatedCv_.wait(lock, isTerminated);
+    } else {
+      terminated = state_->terminatedCv_.wait_for(lock, std::chrono::duration<double>(std::max(timeout, 0.0)), isTerminated);
+    }
+    if (!terminated) {
+      numAbandonedThreads_ = state_->numRunningThreads_ - numOwnThreads;
+    }
+  }
+
+  if (!terminated) {
+    MELO_WARN("Thread pool [%s]: Threads did not terminate within %f s, abandoning them.", name_.c_str(), timeout);
+  }
+  for (auto& thread : threads_) {
+    if (!thread.joinable() || thread.get_id() == std::this_thread::get_id()) {
+      continue;
+    }
+    if (terminated) {
+      thread.join();
+    } else {
+      thread.detach();
+    }
+  }
+  return terminated;
+}
+
+unsigned int ThreadPool::getQueueSize() const {
+  std::lock_guard<std::mutex> lock(state_->mutex_);
+  return static_cast<unsigned int>(state_->tasks_.size());
+}
+
+void ThreadPool::run(const std::shared_ptr<State>& state) {
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(state->mutex_);
+      state->cv_.wait(lock, [&state] { return state->stopRequested_ || !state->tasks_.empty(); });
+      if (state->tasks_.empty()) {
+        // Stop requested and all queued tasks are executed.
+        state->numRunningThreads_--;
+        state->terminatedCv_.notify_all();
+        return;
+      }
+      task = std::move(state->tasks_.front());
+      state->tasks_.pop_front();
+      state->numActive_++;
+    }
+
+    task();
+
+    state->numActive_--;
+    state->numExecuted_++;
+  }
+}
+
+}  // namespace any_worker
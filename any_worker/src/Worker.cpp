@@ -39,9 +39,13 @@
  * @date	July, 2016
  */
 
+#include <algorithm>
 #include <limits>
+#include <numeric>
+#include <vector>
 
 #include <pthread.h>
+#include <unistd.h>
 #include <cstring>  // strerror(..)
 #include <ctime>
 
@@ -66,6 +70,15 @@ Worker::Worker(Worker&& other)
     : options_(std::move(other.options_)),
       running_(other.running_.load()),
       done_(other.done_.load()),
+      parked_(other.parked_.load()),
+      suspended_(other.suspended_.load()),
+      numFailures_(other.numFailures_.load()),
+      numConsecutiveFailures_(other.numConsecutiveFailures_.load()),
+      numFailuresSinceReport_(other.numFailuresSinceReport_),
+      numFailureReports_(other.numFailureReports_.load()),
+      lastFailureReportTime_(other.lastFailureReportTime_),
+      nextFailureReaction_(other.nextFailureReaction_),
+      failureReactionBackoff_(other.failureReactionBackoff_),
       thread_(std::move(other.thread_)),
       rate_(std::move(other.rate_)) {}
 
@@ -85,39 +98,27 @@ bool Worker::start(const int priority) {
     return false;
   }
 
+  // The scheduling is applied under the lock, such that it cannot interleave with a change from another thread.
+  std::lock_guard<std::mutex> lock(mutexScheduling_);
   running_ = true;
   done_ = false;
 
   thread_ = std::thread(&Worker::run, this);
 
-  sched_param sched{};
-  sched.sched_priority = 0;
-  if (priority != 0) {
-    sched.sched_priority = priority;
-  } else if (options_.defaultPriority_ != 0) {
-    sched.sched_priority = options_.defaultPriority_;
+  // Real-time policies are only applied with a priority, the others need none.
+  const int startPriority = priority != 0 ? priority : options_.defaultPriority_;
+  const int policy = options_.schedPolicy_;
+  if (startPriority != 0 || (policy != SCHED_FIFO && policy != SCHED_RR)) {
+    applyScheduling(policy, startPriority);
   }
 
-  if (sched.sched_priority != 0) {
-    if (pthread_setschedparam(thread_.native_handle(), SCHED_FIFO, &sched) != 0) {
-      MELO_WARN("Failed to set thread priority for worker [%s]: %s", options_.name_.c_str(), strerror(errno));
-    }
+  // Set affinity if there is one, the CPU set takes precedence over the single CPU
+  std::vector<int> cpus = options_.schedCpuSet_;
+  if (cpus.empty() && options_.schedAffinity_ != -1) {
+    cpus.push_back(options_.schedAffinity_);
   }
-
-  // Set affinity if there is one
-  if (options_.schedAffinity_ != -1) {
-    if (options_.schedAffinity_ >= CPU_SETSIZE) {
-      MELO_ERROR_STREAM("Selected affinity of " << options_.schedAffinity_ << "is too high. Max allowed is " << CPU_SETSIZE);
-    } else {
-      // Use a CPU set as stated in the manpages
-      cpu_set_t cpuset;
-      CPU_ZERO(&cpuset);
-      CPU_SET(options_.schedAffinity_, &cpuset);
-      auto s = pthread_setaffinity_np(thread_.native_handle(), sizeof(cpuset), &cpuset);
-      if (s != 0) {
-        MELO_ERROR_STREAM("Failed to set thread affinity to " << options_.schedAffinity_);
-      }
-    }
+  if (!cpus.empty()) {
+    applyCpuSet(cpus);
   }
 
   MELO_INFO("Worker [%s] started", options_.name_.c_str());
@@ -125,7 +126,11 @@ bool Worker::start(const int priority) {
 }
 
 void Worker::stop(const bool wait) {
-  running_ = false;
+  {
+    // The thread is joined after releasing the lock, the scheduling is not changed anymore once running_ is false.
+    std::lock_guard<std::mutex> lock(mutexScheduling_);
+    running_ = false;
+  }
 
   // Only wait to stop is not called from within the worker itself (= same thread ID as worker)
   if (thread_.get_id() != std::this_thread::get_id()) {
@@ -152,33 +157,185 @@ void Worker::setEnforceRate(const bool enforceRate) {
   rate_.getOptions().enforceRate_ = enforceRate;
 }
 
+bool Worker::setPriority(const int priority, const int policy) {
+  std::lock_guard<std::mutex> lock(mutexScheduling_);
+  return setScheduling(policy, priority);
+}
+
+bool Worker::setPriority(const int priority) {
+  // The policy is read under the lock, such that the priority is checked against the policy it is applied with.
+  std::lock_guard<std::mutex> lock(mutexScheduling_);
+  return setScheduling(options_.schedPolicy_, priority);
+}
+
+bool Worker::setScheduling(const int policy, const int priority) {
+  const int minPriority = sched_get_priority_min(policy);
+  const int maxPriority = sched_get_priority_max(policy);
+  if (minPriority == -1 || maxPriority == -1 || priority < minPriority || priority > maxPriority) {
+    MELO_ERROR("Cannot change priority of Worker [%s] to %d with policy %d, invalid value.", options_.name_.c_str(), priority, policy);
+    return false;
+  }
+  options_.schedPolicy_ = policy;
+  options_.defaultPriority_ = priority;
+  if (!running_ || !thread_.joinable()) {
+    return true;
+  }
+  return applyScheduling(policy, priority);
+}
+
+bool Worker::setCpuSet(const std::vector<int>& cpus) {
+  std::lock_guard<std::mutex> lock(mutexScheduling_);
+  options_.schedCpuSet_ = cpus;
+  options_.schedAffinity_ = -1;
+  if (!running_ || !thread_.joinable()) {
+    return true;
+  }
+  if (!cpus.empty()) {
+    return applyCpuSet(cpus);
+  }
+  // Release the thread to all CPUs.
+  const auto numCpus = std::max(sysconf(_SC_NPROCESSORS_CONF), 1L);
+  std::vector<int> allCpus(std::min(static_cast<size_t>(numCpus), static_cast<size_t>(CPU_SETSIZE)));
+  std::iota(allCpus.begin(), allCpus.end(), 0);
+  return applyCpuSet(allCpus);
+}
+
+bool Worker::applyScheduling(const int policy, const int priority) {
+  sched_param sched{};
+  sched.sched_priority = priority;
+  const int error = pthread_setschedparam(thread_.native_handle(), policy, &sched);
+  if (error != 0) {
+    MELO_WARN("Failed to set thread priority for worker [%s]: %s", options_.name_.c_str(), strerror(error));
+    return false;
+  }
+  return true;
+}
+
+bool Worker::applyCpuSet(const std::vector<int>& cpus) {
+  // Use a CPU set as stated in the manpages
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  for (const int cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      MELO_ERROR_STREAM("Selected affinity of " << cpu << " is invalid. Max allowed is " << CPU_SETSIZE - 1);
+      return false;
+    }
+    CPU_SET(cpu, &cpuset);
+  }
+  const int error = pthread_setaffinity_np(thread_.native_handle(), sizeof(cpuset), &cpuset);
+  if (error != 0) {
+    MELO_ERROR_STREAM("Failed to set thread affinity for worker [" << options_.name_ << "]: " << strerror(error));
+    return false;
+  }
+  return true;
+}
+
 void Worker::run() {
+  numConsecutiveFailures_ = 0;
+  numFailuresSinceReport_ = 0;
+  failureReactionBackoff_ = 1;
   if (std::isinf(options_.timeStep_)) {
     // Run the callback once.
     static timespec now;
     clock_gettime(CLOCK_MONOTONIC, &now);
-    if (!options_.callback_(WorkerEvent(options_.timeStep_, now))) {
-      MELO_WARN("Worker [%s] callback returned false. Calling failure reaction.", options_.name_.c_str());
-      options_.callbackFailureReaction_();
-    }
+    handleCallbackResult(options_.callback_(WorkerEvent(options_.timeStep_, now)));
   } else {
     // Reset the rate step time.
     rate_.reset();
 
     // Run the callback repeatedly.
     do {
-      if (!options_.callback_(WorkerEvent(options_.timeStep_, rate_.getSleepEndTime()))) {
-        MELO_WARN("Worker [%s] callback returned false. Calling failure reaction.", options_.name_.c_str());
-        options_.callbackFailureReaction_();
+      if (!isActive()) {
+        waitForActivation();
+        continue;
       }
 
+      handleCallbackResult(options_.callback_(createEvent()));
+
       rate_.sleep();
 
     } while (running_);
   }
 
+  reportFailures();
   MELO_INFO("Worker [%s] terminated.", options_.name_.c_str());
   done_ = true;
 }
 
+void Worker::handleCallbackResult(const bool success) {
+  if (!success) {
+    numFailures_++;
+    numConsecutiveFailures_++;
+    numFailuresSinceReport_++;
+  }
+
+  // Report the failures at most once per interval instead of every cycle. Pending failures are also reported by the successes after
+  // them, such that the end of a failure streak is not held back until the next failure.
+  if (numFailuresSinceReport_ > 0) {
+    timespec now{};
+    clock_gettime(options_.clockId_, &now);
+    if (Rate::GetDuration(lastFailureReportTime_, now) >= options_.failureReportInterval_) {
+      reportFailures();
+    }
+  }
+
+  if (success) {
+    numConsecutiveFailures_ = 0;
+    failureReactionBackoff_ = 1;
+    return;
+  }
+
+  // React once the threshold is reached, then back off exponentially while the failures persist.
+  const unsigned int threshold = std::max(options_.failureReactionThreshold_, 1u);
+  if (numConsecutiveFailures_ == threshold) {
+    nextFailureReaction_ = threshold;
+  }
+  if (numConsecutiveFailures_ >= threshold && numConsecutiveFailures_ == nextFailureReaction_) {
+    options_.callbackFailureReaction_();
+    nextFailureReaction_ = numConsecutiveFailures_ + failureReactionBackoff_;
+    failureReactionBackoff_ = std::min(2 * failureReactionBackoff_, std::max(options_.failureReactionMaxBackoff_, 1u));
+  }
+}
+
+void Worker::reportFailures() {
+  if (numFailuresSinceReport_ == 0) {
+    return;
+  }
+  MELO_WARN("Worker [%s] callback returned false %u time(s) since the last report, %u time(s) in a row.", options_.name_.c_str(),
+            numFailuresSinceReport_, numConsecutiveFailures_.load());
+  numFailuresSinceReport_ = 0;
+  numFailureReports_++;
+  clock_gettime(options_.clockId_, &lastFailureReportTime_);
+}
+
+WorkerEvent Worker::createEvent() const {
+  timespec deadline{0, 0};
+  if (options_.timeStep_ > 0.0) {
+    deadline = rate_.getNextStepTime();
+    Rate::AddDuration(deadline, -options_.deadlineSafetyMargin_);
+  }
+  return WorkerEvent(options_.timeStep_, rate_.getSleepEndTime(), deadline, options_.clockId_, rate_.isBehind());
+}
+
+bool Worker::isActive() const {
+  return !suspended_ && (!options_.activationCondition_ || options_.activationCondition_());
+}
+
+void Worker::waitForActivation() {
+  MELO_INFO("Worker [%s] parked, %s.", options_.name_.c_str(), suspended_ ? "suspended" : "activation condition is not fulfilled");
+  parked_ = true;
+
+  timespec wakeUpTime{};
+  clock_gettime(options_.clockId_, &wakeUpTime);
+  while (running_ && !isActive()) {
+    Rate::AddDuration(wakeUpTime, options_.activationCheckTimeStep_);
+    clock_nanosleep(options_.clockId_, TIMER_ABSTIME, &wakeUpTime, nullptr);
+  }
+
+  // Do not catch up on the time steps which were skipped while parked.
+  rate_.restartStepTime();
+  parked_ = false;
+  MELO_INFO("Worker [%s] resumed.", options_.name_.c_str());
+}
+
 }  // namespace any_worker
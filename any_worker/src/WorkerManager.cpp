@@ -4,6 +4,8 @@
  * @date	July, 2016
  */
 
+#include <cmath>
+
 #include "any_worker/WorkerManager.hpp"
 #include "message_logger/message_logger.hpp"
 
@@ -12,6 +14,9 @@ namespace any_worker {
 WorkerManager::WorkerManager() : workers_(), mutexWorkers_() {}
 
 WorkerManager::~WorkerManager() {
+  if (overloadMonitor_) {
+    overloadMonitor_->stop(true);
+  }
   cancelWorkers();
 }
 
@@ -22,6 +27,10 @@ bool WorkerManager::addWorker(const WorkerOptions& options, const bool autostart
     MELO_ERROR("Failed to create worker [%s]", options.name_.c_str());
     return false;
   }
+  // A worker added while the manager is overloaded is degraded like the workers of the same criticality.
+  if (static_cast<int>(options.criticality_) < numDegradedLevels_) {
+    degradeWorker(options.name_, insertedElement.first->second);
+  }
   if (autostart) {
     return insertedElement.first->second.start();
   }
@@ -56,20 +65,36 @@ void WorkerManager::startWorkers() {
 }
 
 void WorkerManager::stopWorker(const std::string& name, const bool wait) {
-  std::lock_guard<std::mutex> lock(mutexWorkers_);
-  auto worker = workers_.find(name);
-  if (worker == workers_.end()) {
-    MELO_ERROR("Cannot stop worker [%s], worker not found", name.c_str());
-    return;
+  std::unordered_map<std::string, Worker> stoppedWorkers;
+  {
+    std::lock_guard<std::mutex> lock(mutexWorkers_);
+    auto worker = workers_.find(name);
+    if (worker == workers_.end()) {
+      MELO_ERROR("Cannot stop worker [%s], worker not found", name.c_str());
+      return;
+    }
+    worker->second.stop(false);
+    if (!wait) {
+      return;
+    }
+    stoppedWorkers.insert(workers_.extract(worker));
   }
-  worker->second.stop(wait);
+  joinWorkers(stoppedWorkers);
 }
 
 void WorkerManager::stopWorkers(const bool wait) {
-  std::lock_guard<std::mutex> lock(mutexWorkers_);
-  for (auto& worker : workers_) {
-    worker.second.stop(wait);
+  std::unordered_map<std::string, Worker> stoppedWorkers;
+  {
+    std::lock_guard<std::mutex> lock(mutexWorkers_);
+    for (auto& worker : workers_) {
+      worker.second.stop(false);
+    }
+    if (!wait) {
+      return;
+    }
+    stoppedWorkers.swap(workers_);
   }
+  joinWorkers(stoppedWorkers);
 }
 
 bool WorkerManager::hasWorker(const std::string& name) {
@@ -78,26 +103,57 @@ bool WorkerManager::hasWorker(const std::string& name) {
 }
 
 void WorkerManager::cancelWorker(const std::string& name, const bool wait) {
-  std::lock_guard<std::mutex> lock(mutexWorkers_);
-  auto worker = workers_.find(name);
-  if (worker == workers_.end()) {
-    MELO_ERROR("Cannot stop worker [%s], worker not found", name.c_str());
-    return;
+  std::unordered_map<std::string, Worker> canceledWorkers;
+  {
+    std::lock_guard<std::mutex> lock(mutexWorkers_);
+    auto worker = workers_.find(name);
+    if (worker == workers_.end()) {
+      MELO_ERROR("Cannot stop worker [%s], worker not found", name.c_str());
+      return;
+    }
+    worker->second.stop(false);
+    canceledWorkers.insert(workers_.extract(worker));
+    numOverruns_.erase(name);
+    throttledTimeSteps_.erase(name);
+    suspendedWorkers_.erase(name);
   }
-  worker->second.stop(wait);
-  workers_.erase(worker);
+  // Join the thread without holding the lock, the destructor joins it at the latest.
+  canceledWorkers.begin()->second.stop(wait);
 }
 
 void WorkerManager::cancelWorkers(const bool wait) {
-  std::lock_guard<std::mutex> lock(mutexWorkers_);
+  std::unordered_map<std::string, Worker> canceledWorkers;
+  {
+    std::lock_guard<std::mutex> lock(mutexWorkers_);
 
-  // signal all workers to stop
-  for (auto& worker : workers_) {
+    // signal all workers to stop
+    for (auto& worker : workers_) {
+      worker.second.stop(false);
+    }
+    canceledWorkers.swap(workers_);
+    numOverruns_.clear();
+    throttledTimeSteps_.clear();
+    suspendedWorkers_.clear();
+  }
+
+  // join the threads without holding the lock, the destructors of the workers join them at the latest
+  for (auto& worker : canceledWorkers) {
     worker.second.stop(wait);
   }
+}
 
-  // call destructors of all workers, which will join the underlying thread
-  workers_.clear();
+void WorkerManager::joinWorkers(std::unordered_map<std::string, Worker>& stoppedWorkers) {
+  // The threads are joined without holding the lock, such that a worker calling the manager from its callback can terminate. The
+  // workers are reinserted afterwards, unless a worker with the same name was added in the meantime.
+  for (auto& worker : stoppedWorkers) {
+    worker.second.stop(true);
+  }
+  std::lock_guard<std::mutex> lock(mutexWorkers_);
+  workers_.merge(stoppedWorkers);
+  for (const auto& worker : stoppedWorkers) {
+    MELO_ERROR("Worker [%s] was added while the stopped worker with the same name was joined, dropping the stopped one.",
+               worker.first.c_str());
+  }
 }
 
 void WorkerManager::setWorkerTimestep(const std::string& name, const double timeStep) {
@@ -107,13 +163,74 @@ void WorkerManager::setWorkerTimestep(const std::string& name, const double time
     MELO_ERROR("Cannot change timestep of worker [%s], worker not found", name.c_str());
     return;
   }
+  // A throttled worker keeps being throttled, with respect to the new time step.
+  auto throttledTimeStep = throttledTimeSteps_.find(name);
+  if (throttledTimeStep != throttledTimeSteps_.end()) {
+    throttledTimeStep->second = timeStep;
+    worker->second.setTimestep(timeStep * overloadOptions_.throttleFactor_);
+    return;
+  }
   worker->second.setTimestep(timeStep);
 }
 
+void WorkerManager::setWorkerSuspended(const std::string& name, const bool suspended) {
+  std::lock_guard<std::mutex> lock(mutexWorkers_);
+  auto worker = workers_.find(name);
+  if (worker == workers_.end()) {
+    MELO_ERROR("Cannot suspend or resume worker [%s], worker not found", name.c_str());
+    return;
+  }
+  // The user takes over, the overload protection does not resume the worker anymore.
+  suspendedWorkers_.erase(name);
+  worker->second.setSuspended(suspended);
+}
+
+bool WorkerManager::setWorkerPriority(const std::string& name, const int priority, const int policy) {
+  std::lock_guard<std::mutex> lock(mutexWorkers_);
+  auto worker = workers_.find(name);
+  if (worker == workers_.end()) {
+    MELO_ERROR("Cannot change priority of worker [%s], worker not found", name.c_str());
+    return false;
+  }
+  return worker->second.setPriority(priority, policy);
+}
+
+bool WorkerManager::setWorkerPriority(const std::string& name, const int priority) {
+  std::lock_guard<std::mutex> lock(mutexWorkers_);
+  auto worker = workers_.find(name);
+  if (worker == workers_.end()) {
+    MELO_ERROR("Cannot change priority of worker [%s], worker not found", name.c_str());
+    return false;
+  }
+  return worker->second.setPriority(priority);
+}
+
+bool WorkerManager::setWorkerCpuSet(const std::string& name, const std::vector<int>& cpus) {
+  std::lock_guard<std::mutex> lock(mutexWorkers_);
+  auto worker = workers_.find(name);
+  if (worker == workers_.end()) {
+    MELO_ERROR("Cannot change CPU set of worker [%s], worker not found", name.c_str());
+    return false;
+  }
+  return worker->second.setCpuSet(cpus);
+}
+
+std::map<std::string, unsigned int> WorkerManager::getNumRateErrors() {
+  std::lock_guard<std::mutex> lock(mutexWorkers_);
+  std::map<std::string, unsigned int> numErrors;
+  for (const auto& worker : workers_) {
+    numErrors.emplace(worker.first, worker.second.getRate().getNumErrors());
+  }
+  return numErrors;
+}
+
 void WorkerManager::cleanDestructibleWorkers() {
   std::lock_guard<std::mutex> lock(mutexWorkers_);
   for (auto it = workers_.begin(); it != workers_.end();) {
     if (it->second.isDestructible()) {
+      numOverruns_.erase(it->first);
+      throttledTimeSteps_.erase(it->first);
+      suspendedWorkers_.erase(it->first);
       it = workers_.erase(it);
     } else {
       ++it;
@@ -121,4 +238,121 @@ void WorkerManager::cleanDestructibleWorkers() {
   }
 }
 
+bool WorkerManager::enableOverloadProtection(const OverloadProtectionOptions& options) {
+  disableOverloadProtection();
+  if (options.checkTimeStep_ <= 0.0 || options.throttleFactor_ < 1.0) {
+    MELO_ERROR("Cannot enable overload protection, invalid check time step %f or throttle factor %f.", options.checkTimeStep_,
+               options.throttleFactor_);
+    return false;
+  }
+  const int minPriority = sched_get_priority_min(options.schedPolicy_);
+  const int maxPriority = sched_get_priority_max(options.schedPolicy_);
+  if (minPriority == -1 || maxPriority == -1 || options.priority_ < minPriority || options.priority_ > maxPriority) {
+    MELO_ERROR("Cannot enable overload protection, invalid priority %d with policy %d.", options.priority_, options.schedPolicy_);
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutexWorkers_);
+    overloadOptions_ = options;
+    numOverruns_.clear();
+    timeWithoutOverload_ = 0.0;
+  }
+  WorkerOptions monitorOptions("overload_protection", options.checkTimeStep_, [this](const WorkerEvent& /*event*/) {
+    checkOverload();
+    return true;
+  });
+  monitorOptions.schedPolicy_ = options.schedPolicy_;
+  monitorOptions.defaultPriority_ = options.priority_;
+  overloadMonitor_ = std::make_unique<Worker>(monitorOptions);
+  return overloadMonitor_->start();
+}
+
+void WorkerManager::disableOverloadProtection() {
+  if (!overloadMonitor_) {
+    return;
+  }
+  overloadMonitor_->stop(true);
+  overloadMonitor_.reset();
+  std::lock_guard<std::mutex> lock(mutexWorkers_);
+  setNumDegradedLevels(0);
+}
+
+void WorkerManager::checkOverload() {
+  std::lock_guard<std::mutex> lock(mutexWorkers_);
+  unsigned int numOverruns = 0;
+  for (const auto& worker : workers_) {
+    if (worker.second.getCriticality() != WorkerCriticality::High) {
+      continue;
+    }
+    const auto& rate = worker.second.getRate();
+    const unsigned int numWorkerOverruns = rate.getNumWarnings() + rate.getNumErrors();
+    // The counters of new or restarted workers start from the current value.
+    auto previous = numOverruns_.emplace(worker.first, numWorkerOverruns).first;
+    if (numWorkerOverruns >= previous->second) {
+      numOverruns += numWorkerOverruns - previous->second;
+    }
+    previous->second = numWorkerOverruns;
+  }
+
+  int numDegradedLevels = numDegradedLevels_;
+  if (numOverruns >= overloadOptions_.overrunThreshold_) {
+    timeWithoutOverload_ = 0.0;
+    if (numDegradedLevels < static_cast<int>(WorkerCriticality::High)) {
+      numDegradedLevels++;
+      MELO_WARN("Worker manager overloaded (%u overruns of high-criticality workers), %d criticality level(s) degraded.", numOverruns,
+                numDegradedLevels);
+    }
+  } else if (numDegradedLevels > 0) {
+    timeWithoutOverload_ += overloadOptions_.checkTimeStep_;
+    if (timeWithoutOverload_ >= overloadOptions_.recoveryTime_) {
+      timeWithoutOverload_ = 0.0;
+      numDegradedLevels--;
+      MELO_INFO("Worker manager recovered from overload, %d criticality level(s) degraded.", numDegradedLevels);
+    }
+  }
+  setNumDegradedLevels(numDegradedLevels);
+}
+
+void WorkerManager::setNumDegradedLevels(const int numDegradedLevels) {
+  // Workers added in the meantime are degraded by addWorker(..), the others only change with the level.
+  if (numDegradedLevels == numDegradedLevels_) {
+    return;
+  }
+  numDegradedLevels_ = numDegradedLevels;
+  for (auto& worker : workers_) {
+    if (static_cast<int>(worker.second.getCriticality()) < numDegradedLevels) {
+      degradeWorker(worker.first, worker.second);
+    } else {
+      restoreWorker(worker.first, worker.second);
+    }
+  }
+}
+
+void WorkerManager::degradeWorker(const std::string& name, Worker& worker) {
+  if (overloadOptions_.reaction_ == OverloadProtectionOptions::Reaction::Park) {
+    // Workers suspended by the user are left alone, such that they are not resumed on restore.
+    if (!worker.isSuspended() && suspendedWorkers_.insert(name).second) {
+      worker.setSuspended(true);
+    }
+    return;
+  }
+  const double timeStep = worker.getTimestep();
+  if (timeStep <= 0.0 || std::isinf(timeStep) || throttledTimeSteps_.count(name) != 0) {
+    return;
+  }
+  throttledTimeSteps_.emplace(name, timeStep);
+  worker.setTimestep(timeStep * overloadOptions_.throttleFactor_);
+}
+
+void WorkerManager::restoreWorker(const std::string& name, Worker& worker) {
+  if (suspendedWorkers_.erase(name) != 0) {
+    worker.setSuspended(false);
+  }
+  auto throttledTimeStep = throttledTimeSteps_.find(name);
+  if (throttledTimeStep != throttledTimeSteps_.end()) {
+    worker.setTimestep(throttledTimeStep->second);
+    throttledTimeSteps_.erase(throttledTimeStep);
+  }
+}
+
 }  // namespace any_worker
@@ -215,6 +215,34 @@ TEST(RateTest, WarningsAndErrors) {  // NOLINT
   EXPECT_EQ(rate.getNumErrors(), 1u);
 }
 
+TEST(RateTest, BehindAndNextStepTime) {  // NOLINT
+  const double timeStep = 0.05;
+  any_worker::Rate rate("Test", timeStep);
+  EXPECT_FALSE(rate.isBehind());
+  EXPECT_NEAR(any_worker::Rate::GetDuration(rate.getStepTime(), rate.getNextStepTime()), timeStep, 1e-9);
+
+  doSomething(0.2 * timeStep);
+  rate.sleep();
+  EXPECT_FALSE(rate.isBehind());
+
+  doSomething(2.0 * timeStep);
+  rate.sleep();
+  EXPECT_TRUE(rate.isBehind());
+
+  rate.reset();
+  EXPECT_FALSE(rate.isBehind());
+}
+
+TEST(RateTest, AddNegativeDuration) {  // NOLINT
+  timespec time{10, 100000000};
+  any_worker::Rate::AddDuration(time, -0.3);
+  EXPECT_EQ(time.tv_sec, 9);
+  EXPECT_EQ(time.tv_nsec, 800000000);
+  any_worker::Rate::AddDuration(time, -2.5);
+  EXPECT_EQ(time.tv_sec, 7);
+  EXPECT_EQ(time.tv_nsec, 300000000);
+}
+
 TEST(RateTest, DISABLED_StatisticsWithEnforceRate) {  // NOLINT
   const double timeStep = 0.1;
   any_worker::Rate rate("Test", timeStep);
@@ -0,0 +1,85 @@
+// std
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+// gtest
+#include <gtest/gtest.h>
+
+// any worker
+#include "any_worker/ThreadPool.hpp"
+
+TEST(ThreadPoolTest, ExecutesAllTasks) {  // NOLINT
+  std::atomic<unsigned int> numCalls{0};
+  {
+    any_worker::ThreadPool pool("Test", 4);
+    EXPECT_EQ(pool.getNumThreads(), 4u);
+    for (unsigned int i = 0; i < 100; i++) {
+      EXPECT_TRUE(pool.submit([&numCalls]() { numCalls++; }));
+    }
+    // Stopping executes the queued tasks.
+    pool.stop();
+    EXPECT_EQ(pool.getNumExecuted(), 100u);
+    EXPECT_FALSE(pool.submit([&numCalls]() { numCalls++; }));
+  }
+  EXPECT_EQ(numCalls, 100u);
+}
+
+TEST(ThreadPoolTest, RejectsTasksIfQueueIsFull) {  // NOLINT
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool release = false;
+  std::atomic<bool> started{false};
+
+  any_worker::ThreadPool pool("Test", 1, 2);
+  // Block the only thread.
+  ASSERT_TRUE(pool.submit([&]() {
+    started = true;
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&release]() { return release; });
+  }));
+  while (!started) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(pool.getNumActive(), 1u);
+
+  EXPECT_TRUE(pool.submit([]() {}));
+  EXPECT_TRUE(pool.submit([]() {}));
+  EXPECT_FALSE(pool.submit([]() {}));
+  EXPECT_EQ(pool.getQueueSize(), 2u);
+  EXPECT_EQ(pool.getNumRejected(), 1u);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    release = true;
+  }
+  cv.notify_all();
+  pool.stop();
+  EXPECT_EQ(pool.getNumExecuted(), 3u);
+  EXPECT_EQ(pool.getQueueSize(), 0u);
+}
+
+TEST(ThreadPoolTest, AbandonsBlockedThreadsAfterTimeout) {  // NOLINT
+  auto release = std::make_shared<std::atomic<bool>>(false);
+  auto finished = std::make_shared<std::atomic<bool>>(false);
+  {
+    any_worker::ThreadPool pool("Test", 1);
+    ASSERT_TRUE(pool.submit([release, finished]() {
+      while (!*release) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      *finished = true;
+    }));
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(pool.stop(0.05));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+  }
+  // The abandoned thread outlives the pool and terminates once its task returns.
+  *release = true;
+  while (!*finished) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
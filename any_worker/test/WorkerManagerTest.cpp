@@ -0,0 +1,186 @@
+// std
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+
+// gtest
+#include <gtest/gtest.h>
+
+// any worker
+#include "any_worker/WorkerManager.hpp"
+
+namespace {
+
+any_worker::WorkerOptions createCountingWorker(const std::string& name, const double timeStep, std::atomic<unsigned int>& numCalls,
+                                               const any_worker::WorkerCriticality criticality) {
+  any_worker::WorkerOptions options(name, timeStep, [&numCalls](const any_worker::WorkerEvent& /*event*/) {
+    numCalls++;
+    return true;
+  });
+  options.criticality_ = criticality;
+  options.activationCheckTimeStep_ = 0.01;
+  return options;
+}
+
+//! Wait until a condition holds, such that the tests do not depend on the scheduling of the workers.
+template <typename Condition>
+bool waitFor(Condition condition, const std::chrono::milliseconds timeout = std::chrono::seconds(2)) {
+  const auto end = std::chrono::steady_clock::now() + timeout;
+  while (!condition()) {
+    if (std::chrono::steady_clock::now() > end) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return true;
+}
+
+}  // namespace
+
+TEST(WorkerManagerTest, StopWhileWorkerCallsManager) {  // NOLINT
+  // Leaked if stopping deadlocks, such that the test fails instead of hanging in the destructor.
+  auto* manager = new any_worker::WorkerManager();
+  std::atomic<unsigned int> numCalls{0};
+  ASSERT_TRUE(manager->addWorker("Caller", 0.001, [manager, &numCalls](const any_worker::WorkerEvent& /*event*/) {
+    manager->getNumRateErrors();
+    numCalls++;
+    return true;
+  }));
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(manager->addWorker("Slow" + std::to_string(i), 0.001, [](const any_worker::WorkerEvent& /*event*/) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      return true;
+    }));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_GT(numCalls, 0u);
+
+  auto stopped = std::async(std::launch::async, [manager]() {
+    manager->stopWorkers(true);
+    manager->startWorkers();
+    manager->cancelWorkers(true);
+  });
+  if (stopped.wait_for(std::chrono::seconds(5)) != std::future_status::ready) {
+    ADD_FAILURE() << "Stopping the workers deadlocked.";
+    new auto(std::move(stopped));
+    return;
+  }
+  EXPECT_FALSE(manager->hasWorker("Caller"));
+  delete manager;
+}
+
+TEST(WorkerManagerTest, OverloadProtection) {  // NOLINT
+  std::atomic<bool> overloaded{true};
+  std::atomic<unsigned int> numLowCalls{0};
+  std::atomic<unsigned int> numNormalCalls{0};
+
+  any_worker::WorkerManager manager;
+  any_worker::WorkerOptions highOptions("High", 0.01, [&overloaded](const any_worker::WorkerEvent& /*event*/) {
+    if (overloaded) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(15));
+    }
+    return true;
+  });
+  highOptions.criticality_ = any_worker::WorkerCriticality::High;
+  ASSERT_TRUE(manager.addWorker(highOptions));
+  ASSERT_TRUE(manager.addWorker(createCountingWorker("Low", 0.01, numLowCalls, any_worker::WorkerCriticality::Low)));
+  ASSERT_TRUE(manager.addWorker(createCountingWorker("Normal", 0.01, numNormalCalls, any_worker::WorkerCriticality::Normal)));
+
+  any_worker::OverloadProtectionOptions options;
+  options.checkTimeStep_ = 0.05;
+  options.recoveryTime_ = 0.1;
+  options.reaction_ = any_worker::OverloadProtectionOptions::Reaction::Park;
+  options.priority_ = 100;
+  EXPECT_FALSE(manager.enableOverloadProtection(options));
+  options.priority_ = 99;
+  ASSERT_TRUE(manager.enableOverloadProtection(options));
+
+  // Both lower criticality levels are parked while the high-criticality worker overruns.
+  EXPECT_TRUE(waitFor([&manager]() { return manager.getNumDegradedLevels() == 2; }));
+  // The workers park at their next activation check.
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  const unsigned int numLowCallsDegraded = numLowCalls;
+  const unsigned int numNormalCallsDegraded = numNormalCalls;
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(numLowCalls, numLowCallsDegraded);
+  EXPECT_EQ(numNormalCalls, numNormalCallsDegraded);
+
+  // The levels are restored once the overload is gone.
+  overloaded = false;
+  EXPECT_TRUE(waitFor([&manager]() { return manager.getNumDegradedLevels() == 0; }));
+  EXPECT_TRUE(waitFor([&]() { return numLowCalls > numLowCallsDegraded && numNormalCalls > numNormalCallsDegraded; }));
+}
+
+TEST(WorkerManagerTest, OverloadProtectionKeepsManuallySuspendedWorker) {  // NOLINT
+  std::atomic<bool> overloaded{true};
+  std::atomic<unsigned int> numLowCalls{0};
+  std::atomic<unsigned int> numSuspendedCalls{0};
+
+  any_worker::WorkerManager manager;
+  any_worker::WorkerOptions highOptions("High", 0.01, [&overloaded](const any_worker::WorkerEvent& /*event*/) {
+    if (overloaded) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(15));
+    }
+    return true;
+  });
+  highOptions.criticality_ = any_worker::WorkerCriticality::High;
+  ASSERT_TRUE(manager.addWorker(highOptions));
+  ASSERT_TRUE(manager.addWorker(createCountingWorker("Low", 0.01, numLowCalls, any_worker::WorkerCriticality::Low)));
+  ASSERT_TRUE(manager.addWorker(createCountingWorker("Suspended", 0.01, numSuspendedCalls, any_worker::WorkerCriticality::Low), false));
+  manager.setWorkerSuspended("Suspended", true);
+  manager.startWorker("Suspended");
+
+  any_worker::OverloadProtectionOptions options;
+  options.checkTimeStep_ = 0.05;
+  options.recoveryTime_ = 0.1;
+  options.reaction_ = any_worker::OverloadProtectionOptions::Reaction::Park;
+  ASSERT_TRUE(manager.enableOverloadProtection(options));
+
+  EXPECT_TRUE(waitFor([&manager]() { return manager.getNumDegradedLevels() >= 1; }));
+
+  // Only the worker parked by the manager is resumed once the overload is gone.
+  overloaded = false;
+  EXPECT_TRUE(waitFor([&manager]() { return manager.getNumDegradedLevels() == 0; }));
+  const unsigned int numLowCallsRestored = numLowCalls;
+  EXPECT_TRUE(waitFor([&]() { return numLowCalls > numLowCallsRestored; }));
+  EXPECT_EQ(numSuspendedCalls, 0u);
+}
+
+TEST(WorkerManagerTest, OverloadProtectionThrottle) {  // NOLINT
+  std::atomic<bool> overloaded{true};
+  std::atomic<unsigned int> numLowCalls{0};
+
+  any_worker::WorkerManager manager;
+  any_worker::WorkerOptions highOptions("High", 0.01, [&overloaded](const any_worker::WorkerEvent& /*event*/) {
+    if (overloaded) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(15));
+    }
+    return true;
+  });
+  highOptions.criticality_ = any_worker::WorkerCriticality::High;
+  ASSERT_TRUE(manager.addWorker(highOptions));
+  ASSERT_TRUE(manager.addWorker(createCountingWorker("Low", 0.01, numLowCalls, any_worker::WorkerCriticality::Low)));
+
+  any_worker::OverloadProtectionOptions options;
+  options.checkTimeStep_ = 0.05;
+  options.recoveryTime_ = 10.0;
+  options.throttleFactor_ = 5.0;
+  ASSERT_TRUE(manager.enableOverloadProtection(options));
+
+  // The low-criticality worker runs at a fifth of its rate.
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  EXPECT_GE(manager.getNumDegradedLevels(), 1);
+  const unsigned int numLowCallsThrottled = numLowCalls;
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  EXPECT_NEAR(numLowCalls - numLowCallsThrottled, 10u, 3u);
+
+  // Disabling the protection restores the time step.
+  overloaded = false;
+  manager.disableOverloadProtection();
+  EXPECT_EQ(manager.getNumDegradedLevels(), 0);
+  const unsigned int numLowCallsRestored = numLowCalls;
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  EXPECT_NEAR(numLowCalls - numLowCallsRestored, 50u, 10u);
+}
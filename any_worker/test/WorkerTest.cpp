@@ -0,0 +1,215 @@
+// std
+#include <pthread.h>
+#include <sched.h>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+// gtest
+#include <gtest/gtest.h>
+
+// any worker
+#include "any_worker/Worker.hpp"
+
+TEST(WorkerTest, ActivationCondition) {  // NOLINT
+  std::atomic<bool> active{false};
+  std::atomic<unsigned int> numCalls{0};
+
+  any_worker::WorkerOptions options("Test", 0.001, [&numCalls](const any_worker::WorkerEvent& /*event*/) {
+    numCalls++;
+    return true;
+  });
+  options.activationCondition_ = [&active]() { return active.load(); };
+  options.activationCheckTimeStep_ = 0.01;
+
+  any_worker::Worker worker(options);
+  ASSERT_TRUE(worker.start());
+
+  // The worker is parked while the condition is not fulfilled.
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_EQ(numCalls, 0u);
+  EXPECT_TRUE(worker.isParked());
+
+  // The worker resumes as soon as the condition is fulfilled.
+  active = true;
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_GT(numCalls, 0u);
+  EXPECT_FALSE(worker.isParked());
+
+  // The worker parks again.
+  active = false;
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  const unsigned int numCallsParked = numCalls;
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(numCalls, numCallsParked);
+
+  worker.stop(true);
+}
+
+TEST(WorkerTest, DeadlineBudget) {  // NOLINT
+  const double timeStep = 0.02;
+  const double safetyMargin = 0.005;
+  std::atomic<unsigned int> numCalls{0};
+  std::atomic<bool> budgetInRange{true};
+  std::atomic<bool> behindAfterOverrun{false};
+
+  any_worker::WorkerOptions options("Test", timeStep, [&](const any_worker::WorkerEvent& event) {
+    const double budget = event.remainingBudget();
+    if (numCalls == 1) {
+      // Overrun the second time step.
+      std::this_thread::sleep_for(std::chrono::duration<double>(2.0 * timeStep));
+    } else if (numCalls == 2) {
+      behindAfterOverrun = event.behind;
+    } else if (numCalls > 2 && !event.behind) {
+      // Only the cycles started on time are checked, the catch-up cycles after the overrun depend on the scheduling.
+      if (budget <= 0.0 || budget > timeStep - safetyMargin) {
+        budgetInRange = false;
+      }
+    }
+    numCalls++;
+    return true;
+  });
+  options.deadlineSafetyMargin_ = safetyMargin;
+
+  any_worker::Worker worker(options);
+  ASSERT_TRUE(worker.start());
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  worker.stop(true);
+
+  EXPECT_GT(numCalls, 5u);
+  EXPECT_TRUE(behindAfterOverrun);
+  EXPECT_TRUE(budgetInRange);
+}
+
+TEST(WorkerTest, NoDeadlineForOneShot) {  // NOLINT
+  std::atomic<double> budget{0.0};
+  any_worker::Worker worker("Test", std::numeric_limits<double>::infinity(), [&budget](const any_worker::WorkerEvent& event) {
+    budget = event.remainingBudget();
+    return true;
+  });
+  ASSERT_TRUE(worker.start());
+  worker.stop(true);
+  EXPECT_TRUE(std::isinf(budget));
+}
+
+TEST(WorkerTest, FailureReactionThresholdAndBackoff) {  // NOLINT
+  std::atomic<unsigned int> numCalls{0};
+  std::atomic<unsigned int> numReactions{0};
+
+  // Fails 20 times in a row, succeeds once, fails 3 times in a row and succeeds from then on.
+  any_worker::WorkerOptions options(
+      "Test", 0.001,
+      [&numCalls](const any_worker::WorkerEvent& /*event*/) {
+        const unsigned int call = ++numCalls;
+        return call == 21 || call > 24;
+      },
+      [&numReactions]() { numReactions++; });
+  options.failureReactionThreshold_ = 3;
+  options.failureReactionMaxBackoff_ = 4;
+
+  any_worker::Worker worker(options);
+  ASSERT_TRUE(worker.start());
+  while (numCalls < 25) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  worker.stop(true);
+
+  // Reactions at the consecutive failures 3, 4, 6, 10, 14, 18 and, after the success, at 3 again.
+  EXPECT_EQ(numReactions, 7u);
+  EXPECT_EQ(worker.getNumFailures(), 23u);
+  EXPECT_EQ(worker.getNumConsecutiveFailures(), 0u);
+}
+
+TEST(WorkerTest, AlternatingFailuresAreReportedPerInterval) {  // NOLINT
+  std::atomic<unsigned int> numCalls{0};
+  any_worker::WorkerOptions options("Test", 0.001, [&numCalls](const any_worker::WorkerEvent& /*event*/) { return ++numCalls % 2 == 0; });
+  options.failureReportInterval_ = 0.1;
+
+  any_worker::Worker worker(options);
+  ASSERT_TRUE(worker.start());
+  std::this_thread::sleep_for(std::chrono::milliseconds(350));
+  worker.stop(true);
+
+  // The first failure is reported immediately, then at most once per interval, and the pending failures when terminating.
+  EXPECT_GE(numCalls, 100u);
+  EXPECT_GE(worker.getNumFailureReports(), 3u);
+  EXPECT_LE(worker.getNumFailureReports(), 6u);
+}
+
+TEST(WorkerTest, SchedulingPolicyAndCpuSet) {  // NOLINT
+  std::atomic<int> policy{-1};
+  std::atomic<bool> onCpuSet{false};
+
+  any_worker::WorkerOptions options("Test", 0.01, [&](const any_worker::WorkerEvent& /*event*/) {
+    sched_param sched{};
+    int currentPolicy = -1;
+    pthread_getschedparam(pthread_self(), &currentPolicy, &sched);
+    policy = currentPolicy;
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    onCpuSet = CPU_ISSET(0, &cpuset) && CPU_COUNT(&cpuset) == 1;
+    return true;
+  });
+  options.schedPolicy_ = SCHED_BATCH;
+  options.schedCpuSet_ = {0};
+
+  any_worker::Worker worker(options);
+  ASSERT_TRUE(worker.start());
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  worker.stop(true);
+
+  EXPECT_EQ(policy, SCHED_BATCH);
+  EXPECT_TRUE(onCpuSet);
+}
+
+TEST(WorkerTest, ChangeSchedulingWhileRunning) {  // NOLINT
+  std::atomic<int> policy{-1};
+  std::atomic<int> numCpus{0};
+
+  any_worker::Worker worker("Test", 0.01, [&](const any_worker::WorkerEvent& /*event*/) {
+    sched_param sched{};
+    int currentPolicy = -1;
+    pthread_getschedparam(pthread_self(), &currentPolicy, &sched);
+    policy = currentPolicy;
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    numCpus = CPU_COUNT(&cpuset);
+    return true;
+  });
+  ASSERT_TRUE(worker.start());
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  const int initialNumCpus = numCpus;
+
+  EXPECT_TRUE(worker.setPriority(0, SCHED_BATCH));
+  EXPECT_TRUE(worker.setCpuSet({0}));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(policy, SCHED_BATCH);
+  EXPECT_EQ(numCpus, 1);
+
+  // Invalid priorities are rejected without changing the scheduling.
+  EXPECT_FALSE(worker.setPriority(0, SCHED_FIFO));
+  EXPECT_FALSE(worker.setPriority(1, SCHED_OTHER));
+  // The priority alone is checked against the current policy, which is kept.
+  EXPECT_FALSE(worker.setPriority(1));
+  EXPECT_TRUE(worker.setPriority(0));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(policy, SCHED_BATCH);
+
+  EXPECT_TRUE(worker.setPriority(0, SCHED_OTHER));
+  EXPECT_TRUE(worker.setCpuSet({}));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  worker.stop(true);
+  EXPECT_EQ(policy, SCHED_OTHER);
+  EXPECT_GE(numCpus, initialNumCpus);
+
+  // Changes of a stopped worker are applied at the next start.
+  EXPECT_TRUE(worker.setPriority(0, SCHED_BATCH));
+  ASSERT_TRUE(worker.start());
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  worker.stop(true);
+  EXPECT_EQ(policy, SCHED_BATCH);
+}
@@ -0,0 +1,33 @@
+/*!
+ * @file    BenchmarkUtils.hpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ *
+ * Helpers shared by the benchmarks of param_io.
+ */
+
+#pragma once
+
+// std
+#include <cstddef>
+#include <vector>
+
+namespace param_io {
+namespace benchmark {
+
+/*!
+ * Get a percentile of measured values, by the nearest rank below it.
+ * @param sortedValues Values sorted in ascending order.
+ * @param percentile   Percentile in the range [0, 100].
+ * @return             Value at the percentile, 0 if there are no values.
+ */
+inline double getPercentile(const std::vector<double>& sortedValues, const double percentile) {
+  if (sortedValues.empty()) {
+    return 0.0;
+  }
+  const auto index = static_cast<size_t>(percentile / 100.0 * static_cast<double>(sortedValues.size() - 1));
+  return sortedValues[index];
+}
+
+}  // namespace benchmark
+}  // namespace param_io
@@ -0,0 +1,219 @@
+/*!
+ * @file    ParamBenchmark.cpp
+ * @author  ANYbotics
+ * @date    Oct 18, 2026
+ *
+ * Benchmark of loading parameters from the parameter server of the local master. A configuration of modules, each containing scalars,
+ * vectors, Eigen and geometry types, is set on the parameter server, then the latency of getParam(..) and param(..) is measured per type
+ * and the time to load the whole configuration is measured.
+ * Every getParam(..) of a structured type reads its fields individually, i.e. costs one round trip to the master per field.
+ *
+ * Private parameters:
+ *  - num_modules:   number of modules in the configuration, default 50.
+ *  - num_loads:     number of times the whole configuration is loaded, default 5.
+ *  - max_load_time: fails if the mean time to load the configuration exceeds this time in seconds, not checked if not positive.
+ */
+
+// std
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+// gtest
+#include <gtest/gtest.h>
+
+// ros
+#include <ros/ros.h>
+
+// param io
+#include <param_io/get_param.hpp>
+
+#include "BenchmarkUtils.hpp"
+
+namespace {
+
+using param_io::benchmark::getPercentile;
+
+using Clock = std::chrono::steady_clock;
+
+constexpr unsigned int NumWeights = 12;
+
+struct Module {
+  double gain_{0.0};
+  int numIterations_{0};
+  bool enabled_{false};
+  uint32_t queueSize_{0};
+  std::string frameId_;
+  std::vector<double> weights_;
+  Eigen::Vector3d offset_{Eigen::Vector3d::Zero()};
+  Eigen::Quaterniond rotation_{Eigen::Quaterniond::Identity()};
+  Eigen::Vector2d limits_{Eigen::Vector2d::Zero()};
+  geometry_msgs::Pose pose_;
+  geometry_msgs::TwistStamped twist_;
+};
+
+std::string getModuleKey(const unsigned int index) {
+  return "benchmark/module_" + std::to_string(index);
+}
+
+XmlRpc::XmlRpcValue createVector3(const double x, const double y, const double z) {
+  XmlRpc::XmlRpcValue value;
+  value["x"] = x;
+  value["y"] = y;
+  value["z"] = z;
+  return value;
+}
+
+XmlRpc::XmlRpcValue createQuaternion() {
+  XmlRpc::XmlRpcValue value = createVector3(0.0, 0.0, 0.0);
+  value["w"] = 1.0;
+  return value;
+}
+
+XmlRpc::XmlRpcValue createModule(const unsigned int index) {
+  XmlRpc::XmlRpcValue module;
+  module["gain"] = 0.5 * index;
+  module["num_iterations"] = static_cast<int>(index);
+  module["enabled"] = index % 2 == 0;
+  module["queue_size"] = 10;
+  module["frame_id"] = std::string("frame_") + std::to_string(index);
+  module["weights"].setSize(NumWeights);
+  for (unsigned int i = 0; i < NumWeights; i++) {
+    module["weights"][static_cast<int>(i)] = 0.1 * i;
+  }
+  module["offset"] = createVector3(0.1, 0.2, 0.3);
+  module["rotation"] = createQuaternion();
+  XmlRpc::XmlRpcValue limits;
+  limits["x"] = -1.0;
+  limits["y"] = 1.0;
+  module["limits"] = limits;
+  module["pose"]["position"] = createVector3(1.0, 2.0, 3.0);
+  module["pose"]["orientation"] = createQuaternion();
+  XmlRpc::XmlRpcValue header;
+  header["seq"] = 0;
+  header["stamp"]["sec"] = 0;
+  header["stamp"]["nsec"] = 0;
+  header["frame_id"] = std::string("base");
+  module["twist"]["header"] = header;
+  module["twist"]["twist"]["linear"] = createVector3(1.0, 2.0, 3.0);
+  module["twist"]["twist"]["angular"] = createVector3(4.0, 5.0, 6.0);
+  return module;
+}
+
+bool loadModule(const ros::NodeHandle& nh, const std::string& key, Module& module) {
+  bool success = true;
+  success = param_io::getParam(nh, key + "/gain", module.gain_) && success;
+  success = param_io::getParam(nh, key + "/num_iterations", module.numIterations_) && success;
+  success = param_io::getParam(nh, key + "/enabled", module.enabled_) && success;
+  success = param_io::getParam(nh, key + "/queue_size", module.queueSize_) && success;
+  success = param_io::getParam(nh, key + "/frame_id", module.frameId_) && success;
+  success = param_io::getParam(nh, key + "/weights", module.weights_) && success;
+  success = param_io::getParam(nh, key + "/offset", module.offset_) && success;
+  success = param_io::getParam(nh, key + "/rotation", module.rotation_) && success;
+  success = param_io::getParam(nh, key + "/limits", module.limits_) && success;
+  success = param_io::getParam(nh, key + "/pose", module.pose_) && success;
+  success = param_io::getParam(nh, key + "/twist", module.twist_) && success;
+  return success;
+}
+
+void printLatencies(const std::string& name, std::vector<double>& latencies) {
+  std::sort(latencies.begin(), latencies.end());
+  std::printf("%28s | %8zu %10.1f %10.1f %10.1f\n", name.c_str(), latencies.size(), getPercentile(latencies, 50.0) * 1e6,
+              getPercentile(latencies, 99.0) * 1e6, latencies.empty() ? 0.0 : latencies.back() * 1e6);
+}
+
+double measure(const std::function<void()>& function) {
+  const auto start = Clock::now();
+  function();
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/*!
+ * Measure getParam(..) and param(..) of a member of all modules.
+ */
+template <typename ParamT>
+void benchmarkType(const ros::NodeHandle& nh, const std::string& typeName, const std::string& member, const unsigned int numModules,
+                   const ParamT& defaultParameter) {
+  std::vector<double> getParamLatencies;
+  std::vector<double> paramLatencies;
+  for (unsigned int i = 0; i < numModules; i++) {
+    const std::string key = getModuleKey(i) + "/" + member;
+    ParamT parameter = defaultParameter;
+    bool success = false;
+    getParamLatencies.push_back(measure([&]() { success = param_io::getParam(nh, key, parameter); }));
+    EXPECT_TRUE(success) << key;
+    paramLatencies.push_back(measure([&]() { parameter = param_io::param(nh, key, defaultParameter); }));
+  }
+  printLatencies("getParam " + typeName, getParamLatencies);
+  printLatencies("param " + typeName, paramLatencies);
+}
+
+}  // namespace
+
+class ParamBenchmark : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    ros::NodeHandle nh("~");
+    numModules_ = static_cast<unsigned int>(std::max(param_io::param(nh, "num_modules", 50), 1));
+    for (unsigned int i = 0; i < numModules_; i++) {
+      nh.setParam(getModuleKey(i), createModule(i));
+    }
+  }
+
+  static void TearDownTestCase() { ros::NodeHandle("~").deleteParam("benchmark"); }
+
+  static unsigned int numModules_;
+};
+
+unsigned int ParamBenchmark::numModules_ = 0;
+
+TEST_F(ParamBenchmark, latencyPerType) {  // NOLINT
+  ros::NodeHandle nh("~");
+
+  std::printf("%28s | %8s %10s %10s %10s\n", "call", "count", "p50 [us]", "p99 [us]", "max [us]");
+  benchmarkType(nh, "double", "gain", numModules_, 0.0);
+  benchmarkType(nh, "int", "num_iterations", numModules_, 0);
+  benchmarkType(nh, "bool", "enabled", numModules_, false);
+  benchmarkType(nh, "uint32_t", "queue_size", numModules_, uint32_t(0));
+  benchmarkType(nh, "std::string", "frame_id", numModules_, std::string());
+  benchmarkType(nh, "std::vector<double>", "weights", numModules_, std::vector<double>());
+  benchmarkType(nh, "Eigen::Vector3d", "offset", numModules_, Eigen::Vector3d(Eigen::Vector3d::Zero()));
+  benchmarkType(nh, "Eigen::Quaterniond", "rotation", numModules_, Eigen::Quaterniond(Eigen::Quaterniond::Identity()));
+  benchmarkType(nh, "Eigen::Vector2d", "limits", numModules_, Eigen::Vector2d(Eigen::Vector2d::Zero()));
+  benchmarkType(nh, "geometry_msgs::Pose", "pose", numModules_, geometry_msgs::Pose());
+  benchmarkType(nh, "geometry_msgs::TwistStamped", "twist", numModules_, geometry_msgs::TwistStamped());
+}
+
+TEST_F(ParamBenchmark, loadConfiguration) {  // NOLINT
+  ros::NodeHandle nh("~");
+  const unsigned int numLoads = static_cast<unsigned int>(std::max(param_io::param(nh, "num_loads", 5), 1));
+  const double maxLoadTime = param_io::param(nh, "max_load_time", 0.0);
+
+  std::vector<double> loadTimes;
+  for (unsigned int load = 0; load < numLoads; load++) {
+    std::vector<Module> modules(numModules_);
+    bool success = true;
+    loadTimes.push_back(measure([&]() {
+      for (unsigned int i = 0; i < numModules_; i++) {
+        success = loadModule(nh, getModuleKey(i), modules[i]) && success;
+      }
+    }));
+    ASSERT_TRUE(success);
+    EXPECT_EQ(modules.back().weights_.size(), NumWeights);
+    EXPECT_EQ(modules.back().twist_.twist.angular.z, 6.0);
+  }
+
+  double meanLoadTime = 0.0;
+  for (const double loadTime : loadTimes) {
+    meanLoadTime += loadTime / numLoads;
+  }
+  std::sort(loadTimes.begin(), loadTimes.end());
+  std::printf("Loaded a configuration of %u modules %u times: mean %.1f ms, min %.1f ms, max %.1f ms\n", numModules_, numLoads,
+              meanLoadTime * 1e3, loadTimes.front() * 1e3, loadTimes.back() * 1e3);
+  if (maxLoadTime > 0.0) {
+    EXPECT_LE(meanLoadTime, maxLoadTime);
+  }
+}